@@ -0,0 +1,148 @@
+#ifndef BENCH_BENCH_HPP_
+#define BENCH_BENCH_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief   Defines and registers a benchmark named "group/name".
+ *
+ * @details The body receives the iteration count as `iterations` and must
+ *          run the measured operation that many times.
+ */
+#define R2D2_BENCHMARK(group, name)                               \
+  static void group##_##name(std::uint64_t iterations);           \
+  static const r2d2_bench::Registrar group##_##name##_registrar{  \
+      #group "/" #name, group##_##name};                          \
+  static void group##_##name([[maybe_unused]] std::uint64_t iterations)
+
+/**
+ * @brief   Defines and registers a self-check named "group/name".
+ *
+ * @details The body returns true if the check passes. Checks run before the
+ *          benchmarks, and a failed check makes r2d2_bench exit with 1.
+ */
+#define R2D2_CHECK(group, name)                                             \
+  static bool group##_##name##_check();                                     \
+  static const r2d2_bench::CheckRegistrar group##_##name##_check_registrar{ \
+      #group "/" #name, group##_##name##_check};                            \
+  static bool group##_##name##_check()
+
+namespace r2d2_bench {
+using BenchmarkFn = void (*)(std::uint64_t);
+using CheckFn = bool (*)();
+
+struct Benchmark {
+  std::string name;
+  BenchmarkFn fn;
+};
+
+/**
+ * @brief   Timing of one benchmark.
+ */
+struct Result {
+  std::string name;
+  std::uint64_t iterations{0};
+  double nsPerOp{0};
+  double minNsPerOp{0};
+  std::size_t repetitions{0};
+};
+
+/**
+ * @brief   Gets the benchmarks registered by R2D2_BENCHMARK.
+ *
+ * @return  Reference to the registry
+ */
+inline std::vector<Benchmark>& registry() {
+  static std::vector<Benchmark> benchmarks_{};
+  return benchmarks_;
+};
+
+struct Registrar {
+  Registrar(const char* name, BenchmarkFn fn) {
+    registry().push_back({name, fn});
+  };
+};
+
+struct Check {
+  std::string name;
+  CheckFn fn;
+};
+
+/**
+ * @brief   Gets the self-checks registered by R2D2_CHECK.
+ *
+ * @return  Reference to the registry
+ */
+inline std::vector<Check>& checks() {
+  static std::vector<Check> checks_{};
+  return checks_;
+};
+
+struct CheckRegistrar {
+  CheckRegistrar(const char* name, CheckFn fn) {
+    checks().push_back({name, fn});
+  };
+};
+
+/**
+ * @brief   Keeps a value alive so the compiler cannot drop its computation.
+ *
+ * @tparam  T     The value type
+ * @param   value The value
+ */
+template <typename T>
+inline void keep(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+};
+
+/**
+ * @brief   Forces pending stores to memory to be considered observable.
+ */
+inline void clobber() { asm volatile("" : : : "memory"); };
+
+/**
+ * @brief   Runs a benchmark.
+ *
+ * @param   bench       The benchmark
+ * @param   minTime     Minimum duration of one repetition
+ * @param   repetitions The number of timed repetitions
+ * @return              The median and best time per operation
+ *
+ * @details The iteration count is doubled until one run lasts minTime, then
+ *          the timed repetitions use that count.
+ */
+inline Result run(const Benchmark& bench, std::chrono::nanoseconds minTime,
+                  std::size_t repetitions) {
+  using Clock = std::chrono::steady_clock;
+  const auto time_{[&](std::uint64_t iterations) {
+    const auto start_{Clock::now()};
+    bench.fn(iterations);
+    return std::chrono::duration<double, std::nano>(Clock::now() - start_)
+        .count();
+  }};
+
+  std::uint64_t iterations_{1};
+  for (double elapsed_{time_(1)};
+       elapsed_ < static_cast<double>(minTime.count()) &&
+       iterations_ < (std::uint64_t{1} << 40);
+       elapsed_ = time_(iterations_))
+    iterations_ *= elapsed_ > 0 ? std::clamp<std::uint64_t>(
+                                      static_cast<std::uint64_t>(
+                                          1.4 * minTime.count() / elapsed_),
+                                      2, 100)
+                                : 100;
+
+  std::vector<double> perOp_(repetitions);
+  for (auto& value_ : perOp_)
+    value_ = time_(iterations_) / static_cast<double>(iterations_);
+  std::sort(perOp_.begin(), perOp_.end());
+  return {bench.name, iterations_, perOp_[perOp_.size() / 2], perOp_.front(),
+          repetitions};
+};
+}  // namespace r2d2_bench
+
+#endif  // BENCH_BENCH_HPP_
@@ -0,0 +1,169 @@
+/**
+ * @brief   Benchmarks of the math, collection, JSON and error utilities.
+ */
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Bench.hpp"
+#include "r2d2_utils_pkg/Collections.hpp"
+#include "r2d2_utils_pkg/Exceptions.hpp"
+#include "r2d2_utils_pkg/Json.hpp"
+#include "r2d2_utils_pkg/Math.hpp"
+#include "r2d2_utils_pkg/Polynome.hpp"
+
+using r2d2_bench::keep;
+
+namespace {
+template <typename T>
+using Vector = std::vector<T>;
+
+template <typename T>
+struct JointHandler {
+  JointHandler(int*, std::string name) : m_name{std::move(name)} {};
+  void update(T value) { m_value = value * T{2} + m_value * T{0.5}; };
+  T value() const { return m_value; };
+
+  std::string m_name;
+  T m_value{};
+};
+
+struct Joints : NamedHandlerVector<Vector, JointHandler, double> {
+  using NamedHandlerVector::NamedHandlerVector;
+};
+
+Joints& joints() {
+  static int node_{0};
+  static Joints joints_{&node_, "base",    "shoulder", "elbow",
+                        "wrist", "nozzle", "payload"};
+  return joints_;
+};
+
+/**
+ * @brief   Writes the configuration file used by the JSON benchmarks.
+ */
+const char* config_name() {
+  static const char* name_{[] {
+    std::ofstream{r2d2_json::getFilePath("r2d2_bench_config")}
+        << R"({"speed": 1.5, "angle_offset": -3.25, "mode": "auto",
+               "joints": [1, 2, 3, 4, 5, 6], "length": 120.0,
+               "stiffness": 2.0, "force_needed": 40, "tolerance": 5})";
+    return "r2d2_bench_config";
+  }()};
+  return name_;
+};
+}  // namespace
+
+R2D2_BENCHMARK(horner, polynome_deg3) {
+  const std::vector<double> coeffs_{0.002, -0.3, 1.5, 4.0};
+  double x_{0.5};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    keep(x_);
+    keep(horner::polynome(coeffs_, x_));
+  }
+}
+
+R2D2_BENCHMARK(horner, polynome_deg7) {
+  const std::vector<double> coeffs_{1e-7, -2e-6, 3e-5, -4e-4,
+                                    5e-3, -0.06, 0.7,  8.0};
+  double x_{0.5};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    keep(x_);
+    keep(horner::polynome(coeffs_, x_));
+  }
+}
+
+R2D2_BENCHMARK(math, sin) {
+  double theta_{0};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    keep(r2d2_math::sin(theta_));
+    theta_ += 0.37;
+  }
+}
+
+R2D2_BENCHMARK(math, fast_sin) {
+  double theta_{0};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    keep(r2d2_math::fast_sin(theta_));
+    theta_ += 0.37;
+  }
+}
+
+R2D2_BENCHMARK(wrapper, wrap_unwrap) {
+  int32_t raw_{12345};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    keep(raw_);
+    const auto angle_{r2d2_process::Angle::unwrap<double>(raw_)};
+    keep(r2d2_process::Angle::wrap<int16_t>(angle_));
+    keep(r2d2_process::Force::unwrap<float>(raw_));
+  }
+}
+
+R2D2_BENCHMARK(collections, lookup_name) {
+  auto& joints_{joints()};
+  const std::string_view names_[]{"elbow", "WRIST", "Payload", "base"};
+  for (std::uint64_t i = 0; i < iterations; ++i)
+    keep(joints_(names_[i & 3]).m_value);
+}
+
+R2D2_BENCHMARK(collections, lookup_symbol) {
+  auto& joints_{joints()};
+  const r2d2_symbol::FoldedSymbol names_[]{
+      r2d2_symbol::find_folded("elbow"), r2d2_symbol::find_folded("wrist"),
+      r2d2_symbol::find_folded("payload"), r2d2_symbol::find_folded("base")};
+  for (std::uint64_t i = 0; i < iterations; ++i)
+    keep(joints_(names_[i & 3]).m_value);
+}
+
+R2D2_BENCHMARK(collections, call_each) {
+  auto& joints_{joints()};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    joints_.call_each(&JointHandler<double>::update, 0.25);
+    r2d2_bench::clobber();
+  }
+}
+
+R2D2_BENCHMARK(collections, get_each) {
+  const auto& joints_{joints()};
+  for (std::uint64_t i = 0; i < iterations; ++i)
+    keep(joints_.get_each(&JointHandler<double>::value));
+}
+
+R2D2_BENCHMARK(json, load) {
+  const char* name_{config_name()};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    const IJsonConfig<> config_{name_};
+    keep(config_);
+  }
+}
+
+R2D2_BENCHMARK(json, getParam) {
+  const IJsonConfig<> config_{config_name()};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    keep(config_.getParam("speed"));
+    keep(config_.getParam<float>("tolerance"));
+  }
+}
+
+R2D2_BENCHMARK(json, try_getParam_missing) {
+  const IJsonConfig<> config_{config_name()};
+  for (std::uint64_t i = 0; i < iterations; ++i)
+    keep(config_.try_getParam("missing").has_value());
+}
+
+R2D2_BENCHMARK(errors, record_repeated) {
+  std::ostringstream sink_{};
+  for (std::uint64_t i = 0; i < iterations; ++i)
+    RECORD_ERROR((r2d2_errors::ErrorInfo{r2d2_errors::ErrorCode::PARAMETER,
+                                         "speed"}));
+  r2d2_errors::agent::report_errors(0, sink_);
+}
+
+R2D2_BENCHMARK(errors, record_exception) {
+  std::ostringstream sink_{};
+  const r2d2_errors::json::ParameterError error_{"angle_offset"};
+  for (std::uint64_t i = 0; i < iterations; ++i) RECORD_ERROR(error_);
+  r2d2_errors::agent::report_errors(0, sink_);
+}
@@ -0,0 +1,93 @@
+/**
+ * @brief   Benchmarks of the debug formatting and string utilities.
+ */
+#include <string>
+#include <string_view>
+
+#include "Bench.hpp"
+#include "r2d2_utils_pkg/Logging/DebugC.hpp"
+#include "r2d2_utils_pkg/Strings.hpp"
+
+using r2d2_bench::keep;
+
+namespace {
+constexpr std::string_view SHORT_TEXT{"Shoulder_Joint"};
+
+const std::string& long_text() {
+  static const std::string text_{[] {
+    std::string text_{};
+    while (text_.size() < 4096) text_ += "Nozzle Force Error Exceeded; ";
+    return text_;
+  }()};
+  return text_;
+};
+}  // namespace
+
+R2D2_BENCHMARK(format, stream_args) {
+  int joint{3};
+  double theta{12.5};
+  const char* state{"auto"};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    keep(joint);
+    keep(stream_args(ANSI_CYAN, DEBUG_VAR_NAMES(joint, theta, state), joint,
+                     theta, state));
+  }
+}
+
+R2D2_BENCHMARK(format, stream_args_c) {
+  int joint{3};
+  double theta{12.5};
+  const char* state{"auto"};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    keep(joint);
+    keep(stream_args_c(ANSI_CYAN, DEBUG_VAR_NAMES(joint, theta, state), joint,
+                       theta, state));
+  }
+}
+
+R2D2_BENCHMARK(format, stream_args_buffer) {
+  int joint{3};
+  double theta{12.5};
+  const char* state{"auto"};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    keep(joint);
+    keep(DEBUG_STREAM_ARGS(ANSI_CYAN, joint, theta, state));
+  }
+}
+
+R2D2_BENCHMARK(strings, upper_short) {
+  for (std::uint64_t i = 0; i < iterations; ++i)
+    keep(r2d2_string::upper(SHORT_TEXT));
+}
+
+R2D2_BENCHMARK(strings, lower_short) {
+  for (std::uint64_t i = 0; i < iterations; ++i)
+    keep(r2d2_string::lower(SHORT_TEXT));
+}
+
+R2D2_BENCHMARK(strings, upper_long) {
+  const std::string& text_{long_text()};
+  for (std::uint64_t i = 0; i < iterations; ++i)
+    keep(r2d2_string::upper(text_));
+}
+
+R2D2_BENCHMARK(strings, lower_long) {
+  const std::string& text_{long_text()};
+  for (std::uint64_t i = 0; i < iterations; ++i)
+    keep(r2d2_string::lower(text_));
+}
+
+R2D2_BENCHMARK(strings, upper_into_long) {
+  const std::string& text_{long_text()};
+  std::string out_{};
+  for (std::uint64_t i = 0; i < iterations; ++i)
+    keep(r2d2_string::upper_into(text_, out_).data());
+}
+
+R2D2_BENCHMARK(strings, iequals) {
+  const std::string_view other_{"shoulder_joint"};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    keep(other_);
+    keep(r2d2_string::iequals(SHORT_TEXT, other_));
+  }
+}
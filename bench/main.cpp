@@ -0,0 +1,206 @@
+/**
+ * @brief   Microbenchmark suite for r2d2_utils_pkg.
+ *
+ * @details Usage: r2d2_bench [--check] [--filter TEXT] [--min-time MS]
+ *                            [--repetitions N] [--json FILE] [--csv FILE]
+ *                            [--baseline FILE] [--threshold PERCENT]
+ *
+ *          First runs the self-checks (e.g. that the vectorized kernels match
+ *          their reference) and exits with 1 if one fails; --check stops
+ *          after them. Then prints a table of the median and best time per
+ *          operation. --json
+ *          and --csv also write the results to files; a JSON file can later
+ *          be passed as --baseline, in which case every benchmark slower
+ *          than the baseline by more than the threshold (default 10%) is
+ *          reported and the exit code is 1.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Bench.hpp"
+
+// Symbols the package leaves to its users
+namespace r2d2_json {
+std::string getFilePath(std::string_view fileName) noexcept {
+  return (std::filesystem::temp_directory_path() / fileName).string() +
+         ".json";
+};
+}  // namespace r2d2_json
+
+namespace r2d2_process::config {
+extern const double g_angleRatio{0.01};
+extern const double g_forceRatio{0.1};
+}  // namespace r2d2_process::config
+
+namespace {
+struct Options {
+  std::string filter{};
+  std::string jsonPath{};
+  std::string csvPath{};
+  std::string baselinePath{};
+  double minTimeMs{50};
+  std::size_t repetitions{5};
+  double threshold{10};
+  bool checkOnly{false};
+};
+
+Options parse_options(int argc, char** argv) {
+  Options options_{};
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg_{argv[i]};
+    if (arg_ == "--check") {
+      options_.checkOnly = true;
+      continue;
+    }
+    if (i + 1 >= argc) throw std::invalid_argument{"missing value"};
+    const char* value_{argv[++i]};
+    if (arg_ == "--filter")
+      options_.filter = value_;
+    else if (arg_ == "--json")
+      options_.jsonPath = value_;
+    else if (arg_ == "--csv")
+      options_.csvPath = value_;
+    else if (arg_ == "--baseline")
+      options_.baselinePath = value_;
+    else if (arg_ == "--min-time")
+      options_.minTimeMs = std::stod(value_);
+    else if (arg_ == "--repetitions")
+      options_.repetitions = std::max<std::size_t>(1, std::stoul(value_));
+    else if (arg_ == "--threshold")
+      options_.threshold = std::stod(value_);
+    else
+      throw std::invalid_argument{"unknown option " + std::string{arg_}};
+  }
+  return options_;
+};
+
+void write_json(const std::string& path,
+                const std::vector<r2d2_bench::Result>& results) {
+  nlohmann::json benchmarks_ = nlohmann::json::array();
+  for (const auto& result_ : results)
+    benchmarks_.push_back({{"name", result_.name},
+                           {"iterations", result_.iterations},
+                           {"repetitions", result_.repetitions},
+                           {"ns_per_op", result_.nsPerOp},
+                           {"min_ns_per_op", result_.minNsPerOp}});
+  const nlohmann::json document_{
+      {"context",
+       {{"compiler", __VERSION__},
+        {"time", std::chrono::duration_cast<std::chrono::seconds>(
+                     std::chrono::system_clock::now().time_since_epoch())
+                     .count()}}},
+      {"benchmarks", benchmarks_}};
+  std::ofstream{path} << document_.dump(2) << '\n';
+};
+
+void write_csv(const std::string& path,
+               const std::vector<r2d2_bench::Result>& results) {
+  std::ofstream file_{path};
+  file_ << "name,iterations,repetitions,ns_per_op,min_ns_per_op\n";
+  for (const auto& result_ : results)
+    file_ << result_.name << ',' << result_.iterations << ','
+          << result_.repetitions << ',' << result_.nsPerOp << ','
+          << result_.minNsPerOp << '\n';
+};
+
+/**
+ * @brief   Compares results with a baseline written by --json.
+ *
+ * @return  The number of regressions
+ */
+std::size_t compare(const std::string& path,
+                    const std::vector<r2d2_bench::Result>& results,
+                    double threshold) {
+  std::ifstream file_{path};
+  if (!file_) throw std::runtime_error{"cannot open baseline " + path};
+  const auto document_ = nlohmann::json::parse(file_);
+  std::unordered_map<std::string, double> baseline_{};
+  for (const auto& entry_ : document_.at("benchmarks"))
+    baseline_[entry_.at("name").get<std::string>()] =
+        entry_.at("ns_per_op").get<double>();
+
+  std::size_t regressions_{0};
+  std::printf("\n%-40s %12s %12s %9s\n", "vs baseline", "base ns/op",
+              "ns/op", "change");
+  for (const auto& result_ : results) {
+    const auto it_{baseline_.find(result_.name)};
+    if (it_ == baseline_.end() || it_->second <= 0) continue;
+    const double change_{(result_.nsPerOp / it_->second - 1) * 100};
+    const bool regressed_{change_ > threshold};
+    regressions_ += regressed_;
+    std::printf("%-40s %12.2f %12.2f %+8.1f%%%s\n", result_.name.c_str(),
+                it_->second, result_.nsPerOp, change_,
+                regressed_ ? "  REGRESSION" : "");
+  }
+  return regressions_;
+};
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options_{};
+  try {
+    options_ = parse_options(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\nUsage: " << argv[0]
+              << " [--check] [--filter TEXT] [--min-time MS] [--repetitions N]"
+                 " [--json FILE] [--csv FILE] [--baseline FILE]"
+                 " [--threshold PERCENT]\n";
+    return 2;
+  }
+
+  std::size_t failed_{0};
+  for (const auto& check_ : r2d2_bench::checks()) {
+    const bool passed_{check_.fn()};
+    failed_ += !passed_;
+    std::printf("check %-34s %s\n", check_.name.c_str(),
+                passed_ ? "ok" : "FAILED");
+  }
+  if (failed_ > 0) return 1;
+  if (options_.checkOnly) return 0;
+  std::printf("\n");
+
+  auto& benchmarks_{r2d2_bench::registry()};
+  std::sort(benchmarks_.begin(), benchmarks_.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return lhs.name < rhs.name;
+            });
+  const std::chrono::nanoseconds minTime_{
+      static_cast<std::int64_t>(options_.minTimeMs * 1e6)};
+
+  std::vector<r2d2_bench::Result> results_{};
+  std::printf("%-40s %14s %12s %12s\n", "benchmark", "iterations", "ns/op",
+              "best ns/op");
+  for (const auto& bench_ : benchmarks_) {
+    if (bench_.name.find(options_.filter) == std::string::npos) continue;
+    results_.push_back(r2d2_bench::run(bench_, minTime_, options_.repetitions));
+    const auto& result_{results_.back()};
+    std::printf("%-40s %14llu %12.2f %12.2f\n", result_.name.c_str(),
+                static_cast<unsigned long long>(result_.iterations),
+                result_.nsPerOp, result_.minNsPerOp);
+    std::fflush(stdout);
+  }
+
+  try {
+    if (!options_.jsonPath.empty()) write_json(options_.jsonPath, results_);
+    if (!options_.csvPath.empty()) write_csv(options_.csvPath, results_);
+    if (!options_.baselinePath.empty() &&
+        compare(options_.baselinePath, results_, options_.threshold) > 0)
+      return 1;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    return 2;
+  }
+  return 0;
+}
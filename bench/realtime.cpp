@@ -0,0 +1,252 @@
+/**
+ * @brief   Benchmarks of the control-loop utilities: channels, wire frames,
+ *          command coalescing, history, contact kernel and fitting.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Bench.hpp"
+#include "r2d2_utils_pkg/Channel.hpp"
+#include "r2d2_utils_pkg/Commands.hpp"
+#include "r2d2_utils_pkg/Contact.hpp"
+#include "r2d2_utils_pkg/Fitting.hpp"
+#include "r2d2_utils_pkg/History.hpp"
+#include "r2d2_utils_pkg/Wire.hpp"
+
+using r2d2_bench::keep;
+
+namespace {
+using Joint = r2d2_type::callback::joint_t<double>;
+using r2d2_commands::ControlType;
+
+constexpr std::size_t JOINTS{256};
+constexpr std::size_t CONTENDING_READERS{2};
+
+/**
+ * @brief   Mutex-protected latest value, the baseline for the channels.
+ */
+template <typename T>
+class MutexValue {
+ private:
+  mutable std::mutex m_mutex{};
+  T m_value{};
+
+ public:
+  void write(const T& value) {
+    std::lock_guard lock_{m_mutex};
+    m_value = value;
+  };
+  T read() const {
+    std::lock_guard lock_{m_mutex};
+    return m_value;
+  };
+};
+
+/**
+ * @brief   Measures writes while reader threads poll the channel.
+ */
+template <typename Channel>
+void contended_writes(Channel& channel, std::uint64_t iterations) {
+  std::atomic<bool> stop_{false};
+  std::vector<std::thread> readers_{};
+  for (std::size_t r = 0; r < CONTENDING_READERS; ++r)
+    readers_.emplace_back([&] {
+      while (!stop_.load(std::memory_order_relaxed)) keep(channel.read());
+    });
+  Joint joint_{0, 0, ControlType::CONTROL_SPEED};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    joint_.theta += 1;
+    channel.write(joint_);
+  }
+  stop_ = true;
+  for (auto& reader_ : readers_) reader_.join();
+};
+
+/**
+ * @brief   Builds a synthetic stream of received joint frames.
+ */
+const std::vector<unsigned char>& joint_stream() {
+  static const std::vector<unsigned char> stream_{[] {
+    std::vector<unsigned char> stream_(JOINTS *
+                                       sizeof(r2d2_type::wire::joint16_t<>));
+    r2d2_type::wire::FrameWriter<> writer_{stream_.data(), stream_.size()};
+    for (std::size_t i = 0; i < JOINTS; ++i)
+      writer_.write(r2d2_type::callback::joint16_t{
+          static_cast<int16_t>(i), static_cast<int16_t>(-i), 0x0A});
+    return stream_;
+  }()};
+  return stream_;
+};
+
+/**
+ * @brief   Calls a contact kernel out of line, as a control tick would.
+ */
+template <auto Kernel>
+[[gnu::noinline]] std::size_t call_contact(
+    const r2d2_contact::ContactParams<double>& params, const double* length,
+    const double* theta, const r2d2_contact::ContactOutput<double>& out) {
+  return Kernel(params, length, theta, JOINTS, out);
+};
+
+/**
+ * @brief   Compares contact() with contact_reference() over two full turns
+ *          each way.
+ *
+ * @tparam  T         Floating-point type
+ * @param   tolerance The allowed error, relative to max(1, |reference|)
+ * @return            true if every output matches and the count agrees with
+ *                    the outputs
+ */
+template <typename T>
+bool check_contact(const T tolerance) {
+  // Odd size, so the vector loop also runs its scalar epilogue
+  constexpr std::size_t COUNT{3893};
+  const auto params_{r2d2_contact::ContactParams<T>{95, 15, 2, 20, 5}};
+  std::vector<T> length_(COUNT), theta_(COUNT);
+  std::vector<T> expected_(3 * COUNT), actual_(3 * COUNT);
+  for (std::size_t i = 0; i < COUNT; ++i) {
+    theta_[i] = static_cast<T>(-720 + 0.37 * static_cast<double>(i));
+    length_[i] = static_cast<T>(50 + i % 51);
+  }
+  const auto output_{[](std::vector<T>& data) {
+    return r2d2_contact::ContactOutput<T>{data.data(), data.data() + COUNT,
+                                          data.data() + 2 * COUNT};
+  }};
+  r2d2_contact::contact_reference(params_, length_.data(), theta_.data(),
+                                  COUNT, output_(expected_));
+  const std::size_t within_{r2d2_contact::contact(
+      params_, length_.data(), theta_.data(), COUNT, output_(actual_))};
+
+  for (std::size_t i = 0; i < expected_.size(); ++i)
+    if (std::abs(actual_[i] - expected_[i]) >
+        tolerance * std::max(T{1}, std::abs(expected_[i])))
+      return false;
+  // Near the tolerance edges the two kernels may disagree; the count must
+  // match contact()'s own outputs
+  std::size_t counted_{0};
+  for (std::size_t i = 0; i < COUNT; ++i)
+    counted_ += std::abs(actual_[2 * COUNT + i]) <= params_.forceTolerance;
+  return within_ == counted_;
+};
+}  // namespace
+
+R2D2_CHECK(contact, matches_reference) {
+  return check_contact<double>(1e-8) && check_contact<float>(1e-3f);
+}
+
+R2D2_BENCHMARK(channel, latest_value_read) {
+  r2d2_channel::LatestValue<Joint> channel_{};
+  channel_.write({1, 2, ControlType::HOLD});
+  for (std::uint64_t i = 0; i < iterations; ++i) keep(channel_.read());
+}
+
+R2D2_BENCHMARK(channel, mutex_read) {
+  MutexValue<Joint> channel_{};
+  channel_.write({1, 2, ControlType::HOLD});
+  for (std::uint64_t i = 0; i < iterations; ++i) keep(channel_.read());
+}
+
+R2D2_BENCHMARK(channel, latest_value_contended_write) {
+  r2d2_channel::LatestValue<Joint> channel_{};
+  contended_writes(channel_, iterations);
+}
+
+R2D2_BENCHMARK(channel, mutex_contended_write) {
+  MutexValue<Joint> channel_{};
+  contended_writes(channel_, iterations);
+}
+
+R2D2_BENCHMARK(channel, triple_buffer_write_read) {
+  r2d2_channel::TripleBuffer<Joint> channel_{};
+  Joint joint_{0, 0, ControlType::CONTROL_SPEED};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    joint_.theta += 1;
+    channel_.write(joint_);
+    keep(channel_.read());
+  }
+}
+
+R2D2_BENCHMARK(wire, decode_joint_stream) {
+  const auto& stream_{joint_stream()};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    int32_t sum_{0};
+    for (const auto& frame_ : r2d2_type::wire::view_span<
+             r2d2_type::wire::joint16_t<>>(stream_.data(), stream_.size()))
+      sum_ += frame_.omega + frame_.theta + frame_.control_word;
+    keep(sum_);
+  }
+}
+
+R2D2_BENCHMARK(wire, write_joint_stream) {
+  std::vector<unsigned char> tx_(JOINTS *
+                                 sizeof(r2d2_type::wire::joint16_t<>));
+  Joint joint_{12.4, -7.6, ControlType::CONTROL_ANGLE};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    r2d2_type::wire::FrameWriter<> writer_{tx_.data(), tx_.size()};
+    do {
+      joint_.omega += 1;
+      keep(joint_);
+    } while (writer_.write(joint_));
+    r2d2_bench::clobber();
+  }
+}
+
+R2D2_BENCHMARK(commands, coalesce_tick) {
+  r2d2_commands::CommandCoalescer<double> coalescer_{JOINTS};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    for (std::size_t joint_ = 0; joint_ < JOINTS; ++joint_) {
+      coalescer_.submit(joint_, {1.0 * i, 0, ControlType::CONTROL_SPEED});
+      coalescer_.submit(joint_, {0, 2.0 * i, ControlType::CONTROL_ANGLE}, 1);
+    }
+    keep(coalescer_.flush([](std::size_t, const Joint& command) {
+      keep(command);
+    }));
+  }
+}
+
+R2D2_BENCHMARK(history, at_cubic) {
+  r2d2_history::History<Joint> history_{1024};
+  for (int64_t t = 0; t < 1024; ++t)
+    history_.push(t * 1000, {0.1 * t, 0.2 * t, ControlType::CONTROL_SPEED});
+  int64_t time_{0};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    time_ = (time_ + 7919) % 1'023'000;
+    keep(history_.at(time_, r2d2_history::Interpolation::CUBIC));
+  }
+}
+
+R2D2_BENCHMARK(contact, reference) {
+  const auto params_{r2d2_contact::ContactParams<double>{95, 15, 2, 20, 5}};
+  std::vector<double> length_(JOINTS, 80), theta_(JOINTS), out_(3 * JOINTS);
+  for (std::size_t i = 0; i < JOINTS; ++i) theta_[i] = 0.3 * i;
+  const r2d2_contact::ContactOutput<double> output_{
+      out_.data(), out_.data() + JOINTS, out_.data() + 2 * JOINTS};
+  for (std::uint64_t i = 0; i < iterations; ++i)
+    keep(call_contact<r2d2_contact::contact_reference<double>>(
+        params_, length_.data(), theta_.data(), output_));
+}
+
+R2D2_BENCHMARK(contact, vectorized) {
+  const auto params_{r2d2_contact::ContactParams<double>{95, 15, 2, 20, 5}};
+  std::vector<double> length_(JOINTS, 80), theta_(JOINTS), out_(3 * JOINTS);
+  for (std::size_t i = 0; i < JOINTS; ++i) theta_[i] = 0.3 * i;
+  const r2d2_contact::ContactOutput<double> output_{
+      out_.data(), out_.data() + JOINTS, out_.data() + 2 * JOINTS};
+  for (std::uint64_t i = 0; i < iterations; ++i)
+    keep(call_contact<r2d2_contact::contact<double>>(
+        params_, length_.data(), theta_.data(), output_));
+}
+
+R2D2_BENCHMARK(fit, rls_update_deg3) {
+  r2d2_fit::RlsFitter<double> fitter_{3, 0.999};
+  double x_{0};
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    x_ = x_ > 90 ? -90 : x_ + 0.1;
+    keep(fitter_.update(x_, 0.002 * x_ * x_ * x_ - 0.3 * x_ + 4));
+  }
+}
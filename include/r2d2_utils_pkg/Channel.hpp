@@ -0,0 +1,173 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_CHANNEL_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_CHANNEL_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace r2d2_channel {
+constexpr std::size_t CACHE_LINE{64};
+
+/**
+ * @brief   Single-writer, multi-reader channel holding the latest value.
+ *
+ * @tparam  T The value type (trivially copyable, e.g. callback::joint_t)
+ *
+ * @details Implemented as a seqlock. The writer never waits: it bumps the
+ *          sequence to odd, stores the value and bumps it to even. Readers
+ *          take no lock; they copy the value and retry if the sequence
+ *          changed meanwhile, so they always get a consistent snapshot and
+ *          never delay the writer. The value is stored as relaxed atomic
+ *          words, which keeps the concurrent copy free of data races.
+ *          Only one thread may call write().
+ */
+template <typename T>
+class LatestValue {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "LatestValue requires a trivially copyable type");
+
+ private:
+  static constexpr std::size_t WORDS{(sizeof(T) + 7) / 8};
+
+  alignas(CACHE_LINE) std::atomic<uint64_t> m_sequence{0};
+  std::array<std::atomic<uint64_t>, WORDS> m_words{};
+
+ public:
+  LatestValue() = default;
+  explicit LatestValue(const T& value) { write(value); };
+  LatestValue(const LatestValue&) = delete;
+  LatestValue& operator=(const LatestValue&) = delete;
+
+  /**
+   * @brief   Publishes a new value.
+   *
+   * @param   value The value
+   */
+  void write(const T& value) noexcept {
+    std::array<uint64_t, WORDS> words_{};
+    std::memcpy(words_.data(), &value, sizeof(T));
+    const uint64_t sequence_{m_sequence.load(std::memory_order_relaxed)};
+    m_sequence.store(sequence_ + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < WORDS; ++i)
+      m_words[i].store(words_[i], std::memory_order_relaxed);
+    m_sequence.store(sequence_ + 2, std::memory_order_release);
+  };
+
+  /**
+   * @brief   Makes a single attempt to read a consistent snapshot.
+   *
+   * @param   value Receives the snapshot on success
+   * @return        false if a write was in progress
+   */
+  [[nodiscard]] bool try_read(T& value) const noexcept {
+    const uint64_t before_{m_sequence.load(std::memory_order_acquire)};
+    if (before_ & 1) return false;
+    std::array<uint64_t, WORDS> words_{};
+    for (std::size_t i = 0; i < WORDS; ++i)
+      words_[i] = m_words[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_sequence.load(std::memory_order_relaxed) != before_) return false;
+    std::memcpy(static_cast<void*>(&value), words_.data(), sizeof(T));
+    return true;
+  };
+
+  /**
+   * @brief   Reads a consistent snapshot.
+   *
+   * @return  The latest value (value-initialized before the first write)
+   *
+   * @details Retries while the writer is mid-update, which lasts a few
+   *          stores; yields after repeated misses in case the writer was
+   *          preempted.
+   */
+  [[nodiscard]] T read() const noexcept {
+    T value_{};
+    for (unsigned tries_ = 1; !try_read(value_); ++tries_)
+      if (tries_ % 64 == 0) std::this_thread::yield();
+    return value_;
+  };
+
+  /**
+   * @brief   Gets the number of completed writes.
+   *
+   * @return  The version, to detect fresh values without reading them
+   */
+  [[nodiscard]] uint64_t version() const noexcept {
+    return m_sequence.load(std::memory_order_acquire) / 2;
+  };
+};
+
+/**
+ * @brief   Single-writer, single-reader channel holding the latest value.
+ *
+ * @tparam  T The value type (trivially copyable)
+ *
+ * @details Triple buffer: the writer fills a back buffer and swaps it with
+ *          the middle one; the reader swaps the middle one with its front
+ *          buffer when it holds a fresh value. Both sides are wait-free and
+ *          copy the value exactly once, which suits large values with a
+ *          single consumer such as the control loop.
+ */
+template <typename T>
+class TripleBuffer {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "TripleBuffer requires a trivially copyable type");
+
+ private:
+  static constexpr uint8_t FRESH{0x4};
+  static constexpr uint8_t INDEX{0x3};
+
+  struct alignas(CACHE_LINE) Slot {
+    T value{};
+  };
+
+  std::array<Slot, 3> m_slots{};
+  alignas(CACHE_LINE) std::atomic<uint8_t> m_middle{1};
+  alignas(CACHE_LINE) uint8_t m_back{0};
+  alignas(CACHE_LINE) uint8_t m_front{2};
+
+ public:
+  TripleBuffer() = default;
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+  /**
+   * @brief   Publishes a new value (writer thread only).
+   *
+   * @param   value The value
+   */
+  void write(const T& value) noexcept {
+    m_slots[m_back].value = value;
+    m_back = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) &
+             INDEX;
+  };
+
+  /**
+   * @brief   Gets the latest value (reader thread only).
+   *
+   * @return  Reference to the latest value, valid until the next read()
+   */
+  [[nodiscard]] const T& read() noexcept {
+    if (m_middle.load(std::memory_order_relaxed) & FRESH)
+      m_front =
+          m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+    return m_slots[m_front].value;
+  };
+
+  /**
+   * @brief   Checks whether a value was written since the last read().
+   *
+   * @return  true if read() will return a new value
+   */
+  [[nodiscard]] bool fresh() const noexcept {
+    return m_middle.load(std::memory_order_relaxed) & FRESH;
+  };
+};
+}  // namespace r2d2_channel
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_CHANNEL_HPP_
@@ -3,8 +3,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
+#include "Errors/Result.hpp"
 #include "Exceptions.hpp"
+#include "Symbols.hpp"
 
 template <template <typename> class Vector, template <typename> class Handler,
           typename T>
@@ -15,7 +21,11 @@ class NamedHandlerVector {
 
  protected:
   Vector<Handler<T>> m_objectVector;
-  std::unordered_map<std::string, size_t> m_indexMap;
+  std::unordered_map<r2d2_symbol::FoldedSymbol, size_t> m_indexMap;
+  std::unordered_map<std::string_view, size_t,
+                     r2d2_string::CaseInsensitiveHash,
+                     r2d2_string::CaseInsensitiveEqual>
+      m_nameMap;
 
  public:
   /**
@@ -27,9 +37,14 @@ class NamedHandlerVector {
    * @param   node   Pointer to the node handle for constructing handlers
    * @param   names  Variadic list of handler names
    *
-   * @details Creates handlers for each name and builds an index map for
-   *          name-based access. Requires at least one name and all names must
-   *          be convertible to string.
+   * @details Creates handlers for each name and builds two index maps, one
+   *          keyed on the folded symbols of the names and one on their
+   *          interned text, so lookups ignore ASCII case and neither touches
+   *          the symbol pool.
+   *          Requires at least one name and all names must be convertible to
+   *          string.
+   *
+   * @throws  std::invalid_argument if two names only differ in ASCII case
    */
   template <typename Node, typename... String>
   NamedHandlerVector(Node* node, String&&... names) {
@@ -39,10 +54,18 @@ class NamedHandlerVector {
                   "All names must be convertible to string!");
     m_objectVector.reserve(size_);
     m_indexMap.reserve(size_);
+    m_nameMap.reserve(size_);
 
     size_t index_{0};
-    ((m_objectVector.emplace_back(node, std::forward<String>(names)),
-      m_indexMap.emplace(std::forward<String>(names), index_++)),
+    const auto index_name_{[&](std::string_view name) {
+      const r2d2_symbol::FoldedSymbol symbol_{r2d2_symbol::intern_folded(name)};
+      if (!m_indexMap.emplace(symbol_, index_).second)
+        throw std::invalid_argument{"NamedHandlerVector: duplicate name " +
+                                    std::string{name}};
+      m_nameMap.emplace(symbol_.str(), index_++);
+    }};
+    ((index_name_(std::string_view{names}),
+      m_objectVector.emplace_back(node, std::forward<String>(names))),
      ...);
   };
 
@@ -55,10 +78,42 @@ class NamedHandlerVector {
    * @throws  r2d2_errors::collections::NameError if the name is not found
    */
   Handler<T>& operator()(std::string_view name) {
-    if (auto it = m_indexMap.find(std::string{name}); it != m_indexMap.end())
-      return m_objectVector[it->second];
+    if (auto result_ = try_get(name)) return *result_;
     throw r2d2_errors::collections::NameError{name};
   };
+  Handler<T>& operator()(r2d2_symbol::FoldedSymbol name) {
+    if (auto result_ = try_get(name)) return *result_;
+    throw r2d2_errors::collections::NameError{name.str()};
+  };
+
+  /**
+   * @brief   Accesses a handler by name without throwing.
+   *
+   * @param   name The name of the handler to access
+   * @return       Result holding a reference to the handler, or
+   *               r2d2_errors::ErrorCode::NAME if the name is not found
+   *
+   * @details Hashes the name ignoring ASCII case; does not lock the symbol
+   *          pool.
+   */
+  r2d2_errors::Result<Handler<T>&> try_get(std::string_view name) {
+    if (auto it = m_nameMap.find(name); it != m_nameMap.end())
+      return m_objectVector[it->second];
+    return r2d2_errors::fail(r2d2_errors::ErrorCode::NAME);
+  };
+
+  /**
+   * @brief   Accesses a handler by name symbol without throwing.
+   *
+   * @param   name The folded symbol of the name (see find_folded())
+   * @return       Result holding a reference to the handler, or
+   *               r2d2_errors::ErrorCode::NAME if the name is not found
+   */
+  r2d2_errors::Result<Handler<T>&> try_get(r2d2_symbol::FoldedSymbol name) {
+    if (auto it = m_indexMap.find(name); it != m_indexMap.end())
+      return m_objectVector[it->second];
+    return r2d2_errors::fail(r2d2_errors::ErrorCode::NAME);
+  };
 
  public:
   /**
@@ -0,0 +1,191 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_COMMANDS_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_COMMANDS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Types.hpp"
+#include "Wire.hpp"
+
+namespace r2d2_commands {
+/**
+ * @brief   Gets the precedence of a control type among pending commands.
+ *
+ * @param   type The control type
+ * @return       HOLD ranks above motion commands so that a stop issued in
+ *               the same tick is never overridden at equal priority
+ */
+constexpr uint8_t rank(ControlType type) noexcept {
+  return type == ControlType::HOLD ? 1 : 0;
+};
+
+/**
+ * @brief   Counters describing what the coalescer saved.
+ */
+struct CoalesceStats {
+  uint64_t submitted{0};
+  uint64_t replaced{0};
+  uint64_t rejected{0};
+  uint64_t outOfRange{0};
+  uint64_t unchanged{0};
+  uint64_t emitted{0};
+};
+
+/**
+ * @brief   Per-joint command slots merged into one frame per tick.
+ *
+ * @tparam  T Type for angular velocity and angle
+ *
+ * @details submit() keeps one pending command per joint. A newer command
+ *          replaces the pending one unless the pending one has a higher
+ *          (priority, rank()) pair. flush() emits the pending commands once,
+ *          in joint order, and optionally skips commands identical to the
+ *          last one sent for that joint, either one by one to a callback or
+ *          as one batched wire frame. Storage is allocated by the
+ *          constructor only. Not thread-safe: submit and flush from the
+ *          control loop.
+ */
+template <typename T>
+class CommandCoalescer {
+ public:
+  using Command = r2d2_type::callback::joint_t<T>;
+
+ private:
+  struct Slot {
+    Command pending{};
+    Command sent{};
+    uint8_t priority{0};
+    bool isPending{false};
+    bool wasSent{false};
+  };
+
+  std::vector<Slot> m_slots{};
+  bool m_skipUnchanged{true};
+  CoalesceStats m_stats{};
+
+  static bool same(const Command& lhs, const Command& rhs) noexcept {
+    return lhs.control_word == rhs.control_word && lhs.omega == rhs.omega &&
+           lhs.theta == rhs.theta;
+  };
+
+ public:
+  /**
+   * @brief   Constructs a coalescer.
+   *
+   * @param   joints        The number of joints
+   * @param   skipUnchanged Whether flush() drops commands equal to the last
+   *                        one sent for the joint
+   */
+  explicit CommandCoalescer(std::size_t joints, bool skipUnchanged = true)
+      : m_slots(joints), m_skipUnchanged{skipUnchanged} {};
+
+  /**
+   * @brief   Submits a command for a joint.
+   *
+   * @param   joint    The joint index
+   * @param   command  The command
+   * @param   priority The priority of the issuer (higher wins)
+   * @return           false if the joint is out of range or the command was
+   *                   rejected in favor of the pending one
+   */
+  bool submit(std::size_t joint, const Command& command,
+              uint8_t priority = 0) noexcept {
+    ++m_stats.submitted;
+    if (joint >= m_slots.size()) {
+      ++m_stats.outOfRange;
+      return false;
+    }
+    Slot& slot_{m_slots[joint]};
+    if (slot_.isPending) {
+      if (slot_.priority > priority ||
+          (slot_.priority == priority &&
+           rank(slot_.pending.control_word) > rank(command.control_word))) {
+        ++m_stats.rejected;
+        return false;
+      }
+      ++m_stats.replaced;
+    }
+    slot_.pending = command;
+    slot_.priority = priority;
+    slot_.isPending = true;
+    return true;
+  };
+
+  /**
+   * @brief   Emits the pending commands and clears them.
+   *
+   * @tparam  F     Callable taking (std::size_t joint, const Command&)
+   * @param   emit  The function receiving each command of the frame
+   * @param   force Whether to emit unchanged commands anyway (e.g. as a
+   *                periodic refresh)
+   * @return        The number of commands emitted
+   */
+  template <typename F>
+  std::size_t flush(F&& emit, bool force = false) {
+    std::size_t count_{0};
+    for (std::size_t joint_ = 0; joint_ < m_slots.size(); ++joint_) {
+      Slot& slot_{m_slots[joint_]};
+      if (!slot_.isPending) continue;
+      slot_.isPending = false;
+      if (m_skipUnchanged && !force && slot_.wasSent &&
+          same(slot_.pending, slot_.sent)) {
+        ++m_stats.unchanged;
+        continue;
+      }
+      emit(joint_, static_cast<const Command&>(slot_.pending));
+      slot_.sent = slot_.pending;
+      slot_.wasSent = true;
+      ++count_;
+    }
+    m_stats.emitted += count_;
+    return count_;
+  };
+
+  /**
+   * @brief   Emits the pending commands as one batched frame.
+   *
+   * @tparam  Order  The byte order on the wire
+   * @param   writer The writer receiving the frame
+   * @param   force  Whether to emit unchanged commands anyway
+   * @return         The number of commands that changed, 0 if no frame was
+   *                 written
+   *
+   * @details The frame holds one wire::joint16_t per joint in joint order,
+   *          the position being the joint index. It is written only when at
+   *          least one joint has a command to emit (see flush()); the other
+   *          joints repeat the last command sent to them, or HOLD if none
+   *          was. Nothing is consumed if the writer cannot hold the whole
+   *          frame.
+   */
+  template <r2d2_type::wire::ByteOrder Order>
+  std::size_t flush(r2d2_type::wire::FrameWriter<Order>& writer,
+                    bool force = false) {
+    if (writer.capacity() - writer.size() <
+        m_slots.size() * sizeof(r2d2_type::wire::joint16_t<Order>))
+      return 0;
+    const std::size_t count_{flush([](std::size_t, const Command&) {}, force)};
+    if (count_ == 0) return 0;
+    for (const auto& slot_ : m_slots) writer.write(slot_.sent);
+    return count_;
+  };
+
+  /**
+   * @brief   Forgets the last sent commands, so the next flush() emits
+   *          everything pending (e.g. after a driver reconnect).
+   */
+  void invalidate() noexcept {
+    for (auto& slot_ : m_slots) slot_.wasSent = false;
+  };
+
+  [[nodiscard]] bool pending(std::size_t joint) const noexcept {
+    return joint < m_slots.size() && m_slots[joint].isPending;
+  };
+  [[nodiscard]] std::size_t size() const noexcept { return m_slots.size(); };
+  [[nodiscard]] const CoalesceStats& stats() const noexcept {
+    return m_stats;
+  };
+};
+}  // namespace r2d2_commands
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_COMMANDS_HPP_
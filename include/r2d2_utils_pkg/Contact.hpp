@@ -0,0 +1,162 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_CONTACT_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_CONTACT_HPP_
+
+#include <cstddef>
+#include <type_traits>
+
+#include "Math.hpp"
+#include "Types.hpp"
+
+// GCC only enables the loop vectorizer from -O3 (cheap loops from -O2 in 12)
+#if defined(__GNUC__) && !defined(__clang__)
+#define R2D2_CONTACT_VECTORIZE [[gnu::optimize("tree-vectorize")]]
+#else
+#define R2D2_CONTACT_VECTORIZE
+#endif
+
+namespace r2d2_contact {
+/**
+ * @brief   Constants shared by every joint of a contact batch.
+ *
+ * @tparam  T Floating-point type
+ */
+template <typename T>
+struct ContactParams {
+  T pipeRadius{};
+  T r0{};
+  T stiffness{1};
+  T forceNeeded{};
+  T forceTolerance{};
+};
+
+/**
+ * @brief   Builds the batch constants from the configuration structs.
+ *
+ * @tparam  T       Floating-point type
+ * @param   pipe    The pipe configuration
+ * @param   nozzle  The nozzle configuration
+ * @param   payload The payload configuration
+ * @return          The batch constants
+ */
+template <typename T>
+[[nodiscard]] constexpr ContactParams<T> make_params(
+    const r2d2_type::config::pipe_t<T>& pipe,
+    const r2d2_type::config::nozzle_t<T>& nozzle,
+    const r2d2_type::config::payload_t<T>& payload) {
+  return {pipe.radius(), nozzle.r0, payload.stiffness, nozzle.force_needed,
+          nozzle.force_tolerance};
+};
+
+/**
+ * @brief   SoA output arrays of a contact batch.
+ *
+ * @tparam  T Floating-point type
+ */
+template <typename T>
+struct ContactOutput {
+  T* radius;
+  T* deflection;
+  T* forceError;
+};
+
+/**
+ * @brief   Computes the contact of one joint (reference implementation).
+ *
+ * @tparam  T      Floating-point type
+ * @param   params The batch constants
+ * @param   length The joint length
+ * @param   theta  The joint angle in degrees
+ * @param   out    The output arrays
+ * @param   index  The joint index in the output arrays
+ * @return         true if the force error is within the tolerance
+ *
+ * @details The nozzle reaches radius = length * sin(theta) + r0 from the
+ *          pipe axis. The part beyond the pipe radius is the deflection, the
+ *          payload presses with stiffness * deflection and the error is
+ *          force_needed minus that force.
+ */
+template <typename T>
+bool contact_one(const ContactParams<T>& params, const T length,
+                 const T theta, const ContactOutput<T>& out,
+                 const std::size_t index) {
+  const T radius_{length * r2d2_math::sin(theta) + params.r0};
+  const T deflection_{r2d2_math::max(radius_ - params.pipeRadius, T{0})};
+  const T error_{params.forceNeeded - params.stiffness * deflection_};
+  out.radius[index] = radius_;
+  out.deflection[index] = deflection_;
+  out.forceError[index] = error_;
+  return r2d2_math::abs(error_) <= params.forceTolerance;
+};
+
+/**
+ * @brief   Computes the contact of every joint with scalar code.
+ *
+ * @tparam  T      Floating-point type
+ * @param   params The batch constants
+ * @param   length The joint lengths
+ * @param   theta  The joint angles in degrees
+ * @param   count  The number of joints
+ * @param   out    The output arrays
+ * @return         The number of joints within the force tolerance
+ */
+template <typename T>
+std::size_t contact_reference(const ContactParams<T>& params,
+                              const T* length, const T* theta,
+                              const std::size_t count,
+                              const ContactOutput<T>& out) {
+  std::size_t within_{0};
+  for (std::size_t i = 0; i < count; ++i)
+    within_ += contact_one(params, length[i], theta[i], out, i);
+  return within_;
+};
+
+/**
+ * @brief   Computes the contact of every joint in one vectorized pass.
+ *
+ * @tparam  T      Floating-point type
+ * @param   params The batch constants
+ * @param   length The joint lengths
+ * @param   theta  The joint angles in degrees
+ * @param   count  The number of joints
+ * @param   out    The output arrays (must not alias the inputs)
+ * @return         The number of joints within the force tolerance
+ *
+ * @details Same model as contact_one(), written branch-free over SoA arrays
+ *          with r2d2_math::fast_sin() so that the compiler emits SIMD code
+ *          for the whole loop. GCC vectorizes it at -O2 too, through
+ *          R2D2_CONTACT_VECTORIZE; other compilers need -O3. Results match
+ *          contact_reference() to the accuracy of fast_sin(), which the
+ *          r2d2_bench --check self-test verifies.
+ */
+template <typename T>
+R2D2_CONTACT_VECTORIZE std::size_t contact(const ContactParams<T>& params,
+                                           const T* __restrict length,
+                                           const T* __restrict theta,
+                                           const std::size_t count,
+                                           const ContactOutput<T>& out) {
+  static_assert(std::is_floating_point_v<T>,
+                "contact: T must be a floating-point type!");
+  T* __restrict radius_{out.radius};
+  T* __restrict deflection_{out.deflection};
+  T* __restrict forceError_{out.forceError};
+  const T pipeRadius_{params.pipeRadius}, r0_{params.r0};
+  const T stiffness_{params.stiffness}, needed_{params.forceNeeded};
+  const T tolerance_{params.forceTolerance};
+
+#pragma GCC ivdep
+  for (std::size_t i = 0; i < count; ++i) {
+    const T reach_{length[i] * r2d2_math::fast_sin(theta[i]) + r0_};
+    const T bend_{r2d2_math::max(reach_ - pipeRadius_, T{0})};
+    radius_[i] = reach_;
+    deflection_[i] = bend_;
+    forceError_[i] = needed_ - stiffness_ * bend_;
+  }
+  // Counted separately: mixing the count into the loop above blocks SIMD
+  std::size_t within_{0};
+  for (std::size_t i = 0; i < count; ++i)
+    within_ += r2d2_math::abs(forceError_[i]) <= tolerance_;
+  return within_;
+};
+}  // namespace r2d2_contact
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_CONTACT_HPP_
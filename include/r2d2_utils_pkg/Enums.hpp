@@ -0,0 +1,190 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_ENUMS_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_ENUMS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+#include "Strings.hpp"
+
+namespace r2d2_enum {
+/**
+ * @brief   One enumerator and its name.
+ *
+ * @tparam  E The enum type
+ */
+template <typename E>
+struct EnumEntry {
+  E value;
+  std::string_view name;
+};
+
+/**
+ * @brief   Gets the number of hash slots for a table of the specified size.
+ *
+ * @param   count The number of entries
+ * @return        The smallest power of two not below twice the count
+ */
+constexpr std::size_t slot_count(std::size_t count) noexcept {
+  std::size_t slots_{1};
+  while (slots_ < 2 * count) slots_ <<= 1;
+  return slots_;
+};
+
+/**
+ * @brief   Maps a name to a hash slot, ignoring ASCII case.
+ *
+ * @param   text The name
+ * @param   seed The table seed
+ * @param   mask The number of slots minus one
+ * @return       The slot index
+ */
+constexpr std::size_t slot_of(std::string_view text, std::uint64_t seed,
+                              std::size_t mask) noexcept {
+  std::uint64_t hash_{static_cast<std::uint64_t>(r2d2_string::ihash(text)) ^
+                      (seed * 0x9E3779B97F4A7C15ull)};
+  hash_ ^= hash_ >> 32;
+  hash_ *= 0xFF51AFD7ED558CCDull;
+  hash_ ^= hash_ >> 29;
+  return static_cast<std::size_t>(hash_) & mask;
+};
+
+/**
+ * @brief   Constexpr bidirectional table between enumerators and names.
+ *
+ * @tparam  E The enum type
+ * @tparam  N The number of enumerators
+ *
+ * @details Names are parsed through a perfect hash whose seed is searched at
+ *          compile time, so parse() hashes the input once, probes a single
+ *          slot and compares one name. Names are matched ignoring ASCII case
+ *          and must be unique under that rule. name() scans the entries,
+ *          which is a handful of compares for the enums in this package.
+ */
+template <typename E, std::size_t N>
+class EnumTable {
+  static_assert(N > 0 && N < 0xFF, "EnumTable needs 1 to 254 entries");
+
+ public:
+  static constexpr std::size_t SLOTS{slot_count(N)};
+
+ private:
+  std::array<EnumEntry<E>, N> m_entries{};
+  std::array<std::uint8_t, SLOTS> m_slots{};
+  std::uint64_t m_seed{0};
+
+  constexpr bool try_seed() noexcept {
+    for (auto& slot_ : m_slots) slot_ = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+      auto& slot_ = m_slots[slot_of(m_entries[i].name, m_seed, SLOTS - 1)];
+      if (slot_ != 0) return false;
+      slot_ = static_cast<std::uint8_t>(i + 1);
+    }
+    return true;
+  };
+
+ public:
+  /**
+   * @brief   Constructs the table and its perfect hash.
+   *
+   * @param   entries The enumerators and their names
+   *
+   * @details Fails to compile when used in a constant expression with
+   *          duplicate names.
+   */
+  constexpr explicit EnumTable(const EnumEntry<E> (&entries)[N]) {
+    for (std::size_t i = 0; i < N; ++i) {
+      for (std::size_t j = 0; j < i; ++j)
+        if (r2d2_string::iequals(entries[i].name, entries[j].name))
+          throw std::logic_error{"EnumTable: duplicate name"};
+      m_entries[i] = entries[i];
+    }
+    while (!try_seed()) ++m_seed;
+  };
+
+  /**
+   * @brief   Gets the name of an enumerator.
+   *
+   * @param   value The enumerator
+   * @return        The name, or an empty view if the value is not listed
+   */
+  [[nodiscard]] constexpr std::string_view name(E value) const noexcept {
+    for (const auto& entry_ : m_entries)
+      if (entry_.value == value) return entry_.name;
+    return {};
+  };
+
+  /**
+   * @brief   Parses a name, ignoring ASCII case.
+   *
+   * @param   text The name
+   * @return       The enumerator, or std::nullopt if the name is not listed
+   */
+  [[nodiscard]] constexpr std::optional<E> parse(
+      std::string_view text) const noexcept {
+    const std::uint8_t index_{m_slots[slot_of(text, m_seed, SLOTS - 1)]};
+    if (index_ == 0) return std::nullopt;
+    const auto& entry_ = m_entries[index_ - 1];
+    if (!r2d2_string::iequals(entry_.name, text)) return std::nullopt;
+    return entry_.value;
+  };
+
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return N; };
+  [[nodiscard]] constexpr auto begin() const noexcept {
+    return m_entries.begin();
+  };
+  [[nodiscard]] constexpr auto end() const noexcept { return m_entries.end(); };
+};
+
+/**
+ * @brief   Creates an EnumTable from a braced list of entries.
+ *
+ * @tparam  E       The enum type
+ * @tparam  N       The number of entries
+ * @param   entries The enumerators and their names
+ * @return          The table
+ */
+template <typename E, std::size_t N>
+constexpr EnumTable<E, N> make_table(const EnumEntry<E> (&entries)[N]) {
+  return EnumTable<E, N>{entries};
+};
+
+/**
+ * @brief   Traits holding the name table of an enum.
+ *
+ * @tparam  E The enum type
+ *
+ * @details Must be specialized with a static constexpr member named table.
+ */
+template <typename E>
+struct EnumTraits;
+
+/**
+ * @brief   Gets the name of an enumerator.
+ *
+ * @tparam  E     The enum type
+ * @param   value The enumerator
+ * @return        The name, or an empty view if the value is not listed
+ */
+template <typename E>
+constexpr std::string_view to_string(E value) noexcept {
+  return EnumTraits<E>::table.name(value);
+};
+
+/**
+ * @brief   Parses an enumerator from its name, ignoring ASCII case.
+ *
+ * @tparam  E    The enum type
+ * @param   text The name
+ * @return       The enumerator, or std::nullopt if the name is not listed
+ */
+template <typename E>
+constexpr std::optional<E> from_string(std::string_view text) noexcept {
+  return EnumTraits<E>::table.parse(text);
+};
+}  // namespace r2d2_enum
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_ENUMS_HPP_
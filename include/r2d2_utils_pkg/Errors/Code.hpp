@@ -0,0 +1,131 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_CODE_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_CODE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace r2d2_errors {
+constexpr std::size_t ERROR_ARG_LEN{128};
+
+enum class ErrorCode : std::uint8_t {
+  UNKNOWN = 0,
+  NAME,
+  FILE_NOT_FOUND,
+  PARAMETER,
+  OBJECT_PARSE,
+  FILE_PARSE,
+  TYPE
+};
+
+struct ErrorFormat {
+  std::string_view type;
+  std::string_view prefix;
+  std::string_view suffix;
+};
+
+// Indexed by ErrorCode; UNKNOWN carries the full message as its argument
+constexpr std::array<ErrorFormat, 7> ERROR_FORMATS{
+    {{"Exception", "", ""},
+     {"NameError", "Name \"", "\" is not found!"},
+     {"FileNotFoundError", "File \"", ".json\"is not found!"},
+     {"ParameterError", "Parameter \"", "\" is not found!"},
+     {"ObjectParseError", "Object \"", "\" is not found!"},
+     {"FileParseError", "File \"", ".json\" cannot be parsed!"},
+     {"TypeError", "Parameter \"", "\" has a wrong type!"}}};
+
+constexpr std::size_t ERROR_WHAT_LEN{ERROR_ARG_LEN + 32};
+
+/**
+ * @brief   Gets the message format for an error code.
+ *
+ * @param   code The error code
+ * @return       The type name, message prefix and message suffix
+ */
+constexpr ErrorFormat format_of(ErrorCode code) noexcept {
+  return ERROR_FORMATS[static_cast<std::size_t>(code)];
+};
+
+/**
+ * @brief   Structured, allocation-free representation of an error.
+ *
+ * @details Stores an error code and a small inline argument (a key, a name or,
+ *          for ErrorCode::UNKNOWN, the whole message). Arguments longer than
+ *          ERROR_ARG_LEN are truncated. The human-readable message is only
+ *          built when format() or operator<< is called.
+ */
+struct ErrorInfo {
+  ErrorCode code{};
+  std::uint8_t len{};
+  std::array<char, ERROR_ARG_LEN> arg{};
+
+  ErrorInfo() = default;
+
+  /**
+   * @brief   Constructs an ErrorInfo from a code and an argument.
+   *
+   * @param   code The error code
+   * @param   arg  The argument (truncated to ERROR_ARG_LEN characters)
+   */
+  ErrorInfo(ErrorCode code, std::string_view arg) noexcept : code{code} {
+    len = static_cast<std::uint8_t>(arg.copy(this->arg.data(), ERROR_ARG_LEN));
+  };
+
+  /**
+   * @brief   Gets the stored argument.
+   *
+   * @return  View of the inline argument
+   */
+  [[nodiscard]] std::string_view argument() const noexcept {
+    return {arg.data(), len};
+  };
+
+  /**
+   * @brief   Formats the human-readable message into a buffer.
+   *
+   * @param   dst The destination buffer
+   * @param   cap The buffer capacity, including the null terminator
+   * @return      The length of the message (excluding null terminator)
+   */
+  std::size_t format(char* dst, std::size_t cap) const noexcept {
+    if (cap == 0) return 0;
+    const auto format_{format_of(code)};
+    std::size_t pos_{0};
+    for (auto part_ : {format_.prefix, argument(), format_.suffix})
+      pos_ += part_.copy(dst + pos_, cap - 1 - pos_);
+    dst[pos_] = '\0';
+    return pos_;
+  };
+};
+static_assert(ERROR_ARG_LEN <= UINT8_MAX, "ErrorInfo::len is 8 bits wide!");
+
+/**
+ * @brief   Streams the human-readable message of an error.
+ *
+ * @param   os   The output stream
+ * @param   info The error to stream
+ * @return       Reference to the output stream
+ */
+inline std::ostream& operator<<(std::ostream& os, const ErrorInfo& info) {
+  const auto format_{format_of(info.code)};
+  return os << format_.prefix << info.argument() << format_.suffix;
+};
+
+/**
+ * @brief   Interface of exceptions that carry an ErrorInfo.
+ *
+ * @details Lets the error agent record the structured form of an exception
+ *          instead of its formatted message.
+ */
+class IStructuredError {
+ public:
+  [[nodiscard]] virtual const ErrorInfo& info() const noexcept = 0;
+
+ protected:
+  ~IStructuredError() = default;
+};
+}  // namespace r2d2_errors
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_CODE_HPP_
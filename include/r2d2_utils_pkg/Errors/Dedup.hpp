@@ -0,0 +1,216 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_DEDUP_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_DEDUP_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#include "Code.hpp"
+
+namespace r2d2_errors::agent {
+constexpr std::size_t ERROR_TABLE_CAPACITY{64};
+constexpr std::size_t ERROR_TABLE_PROBES{8};
+constexpr std::size_t ERROR_TABLE_CLAIM_SPINS{64};
+
+/**
+ * @brief   Summary of repeated occurrences of the same error.
+ */
+struct ErrorSummary {
+  const ErrorInfo& info;
+  std::uint64_t count;
+  std::int64_t spanNs;
+};
+
+/**
+ * @brief   Streams an error summary as `Type "arg" ×N in T s`.
+ *
+ * @param   os      The output stream
+ * @param   summary The summary to stream
+ * @return          Reference to the output stream
+ *
+ * @details A single occurrence is streamed as the plain error message.
+ */
+inline std::ostream& operator<<(std::ostream& os,
+                                const ErrorSummary& summary) {
+  if (summary.count == 1) return os << summary.info;
+  if (summary.info.code == ErrorCode::UNKNOWN)
+    os << summary.info.argument();
+  else
+    os << format_of(summary.info.code).type << " \""
+       << summary.info.argument() << "\"";
+  return os << " ×" << summary.count << " in "
+            << static_cast<double>(summary.spanNs) / 1e9 << " s";
+};
+
+/**
+ * @brief   Fixed-size table that deduplicates errors by code and argument.
+ *
+ * @tparam  Capacity Number of entries (must be a power of two)
+ * @tparam  Probes   Maximum number of entries probed per record
+ *
+ * @details Producers look up an entry by a hash of the code and argument with
+ *          bounded linear probing and either bump its counter and last-seen
+ *          timestamp or claim a free entry; record() never allocates and
+ *          never blocks. A producer that meets an entry being claimed for the
+ *          same hash spins at most ERROR_TABLE_CLAIM_SPINS times for it to be
+ *          published, then moves on to the next entry, so a preempted
+ *          claimer can at worst cause a duplicate entry. Entries are never
+ *          evicted: memory stays constant under a sustained error storm.
+ *          record() returns false when no entry could be found or claimed,
+ *          letting the caller fall back to another sink.
+ *          Only one thread may call report() at a time.
+ */
+template <std::size_t Capacity, std::size_t Probes>
+class ErrorTable {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two!");
+  static_assert(Probes > 0 && Probes <= Capacity,
+                "Probes must be in range [1, Capacity]!");
+
+ private:
+  enum EntryState : std::uint8_t { FREE = 0, WRITING, READY };
+
+  struct Entry {
+    std::atomic<std::uint8_t> state{FREE};
+    std::atomic<std::uint64_t> hash{0};
+    ErrorInfo info{};
+    std::int64_t firstSeen{};
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::int64_t> lastSeen{0};
+    // Owned by the consumer
+    std::uint64_t reported{0};
+    std::int64_t lastReport{0};
+  };
+
+  std::array<Entry, Capacity> m_entries{};
+  alignas(64) std::atomic<std::uint64_t> m_unreported{0};
+
+ public:
+  /**
+   * @brief   Counts an occurrence of an error.
+   *
+   * @param   info  The error to count
+   * @param   nowNs The current steady-clock time in nanoseconds
+   * @return        True if the error was counted, false if the table is full
+   */
+  bool record(const ErrorInfo& info, std::int64_t nowNs) noexcept {
+    const std::uint64_t hash_{hash_of(info)};
+    for (std::size_t i = 0; i < Probes; ++i) {
+      Entry& entry_{m_entries[(hash_ + i) & (Capacity - 1)]};
+      std::uint8_t state_{entry_.state.load(std::memory_order_acquire)};
+      if (state_ == FREE &&
+          entry_.state.compare_exchange_strong(state_, WRITING,
+                                               std::memory_order_acquire,
+                                               std::memory_order_acquire)) {
+        entry_.hash.store(hash_, std::memory_order_release);
+        entry_.info = info;
+        entry_.firstSeen = nowNs;
+        entry_.lastSeen.store(nowNs, std::memory_order_relaxed);
+        entry_.count.store(1, std::memory_order_relaxed);
+        m_unreported.fetch_add(1, std::memory_order_relaxed);
+        entry_.state.store(READY, std::memory_order_release);
+        return true;
+      }
+      // The entry may be claimed for this very error: give the claimer a
+      // few spins to publish it (an unset hash may still turn out to be
+      // ours), then treat it as a miss rather than block
+      for (std::size_t spin_ = 0;
+           state_ == WRITING && spin_ < ERROR_TABLE_CLAIM_SPINS; ++spin_) {
+        const std::uint64_t claimed_{
+            entry_.hash.load(std::memory_order_acquire)};
+        if (claimed_ != 0 && claimed_ != hash_) break;
+        state_ = entry_.state.load(std::memory_order_acquire);
+      }
+      if (state_ != READY ||
+          entry_.hash.load(std::memory_order_relaxed) != hash_ ||
+          !matches(entry_, info))
+        continue;
+      m_unreported.fetch_add(1, std::memory_order_relaxed);
+      entry_.lastSeen.store(nowNs, std::memory_order_relaxed);
+      entry_.count.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  };
+
+  /**
+   * @brief   Reports every entry with new occurrences whose emit period has
+   *          elapsed.
+   *
+   * @tparam  Func     Callable taking a const ErrorSummary&
+   * @param   nowNs    The current steady-clock time in nanoseconds
+   * @param   periodNs Minimum time between two reports of the same entry;
+   *                   a non-positive value reports every pending entry
+   * @param   func     The callback invoked for each summary
+   * @return           The number of reported occurrences
+   *
+   * @details The first occurrence of an entry is reported immediately.
+   */
+  template <typename Func>
+  std::uint64_t report(std::int64_t nowNs, std::int64_t periodNs,
+                       Func&& func) {
+    std::uint64_t total_{0};
+    for (auto& entry_ : m_entries) {
+      if (entry_.state.load(std::memory_order_acquire) != READY) continue;
+      const std::uint64_t count_{entry_.count.load(std::memory_order_relaxed)};
+      if (count_ == entry_.reported) continue;
+      const bool first_{entry_.reported == 0};
+      if (!first_ && nowNs - entry_.lastReport < periodNs) continue;
+
+      const std::int64_t since_{first_ ? entry_.firstSeen
+                                       : entry_.lastReport};
+      const std::int64_t last_{
+          entry_.lastSeen.load(std::memory_order_relaxed)};
+      func(ErrorSummary{entry_.info, count_ - entry_.reported,
+                        last_ > since_ ? last_ - since_ : 0});
+      total_ += count_ - entry_.reported;
+      entry_.reported = count_;
+      entry_.lastReport = nowNs;
+    }
+    m_unreported.fetch_sub(total_, std::memory_order_relaxed);
+    return total_;
+  };
+
+  /**
+   * @brief   Checks whether any counted occurrence is still unreported.
+   *
+   * @return  True if report() has pending occurrences
+   */
+  [[nodiscard]] bool empty() const noexcept {
+    return m_unreported.load(std::memory_order_relaxed) == 0;
+  };
+
+ private:
+  /**
+   * @brief   Computes the FNV-1a hash of an error code and argument.
+   *
+   * @param   info The error to hash
+   * @return       The 64-bit hash
+   */
+  static std::uint64_t hash_of(const ErrorInfo& info) noexcept {
+    std::uint64_t hash_{0xcbf29ce484222325ULL};
+    auto mix_ = [&hash_](std::uint8_t byte) {
+      hash_ = (hash_ ^ byte) * 0x100000001b3ULL;
+    };
+    mix_(static_cast<std::uint8_t>(info.code));
+    for (const char chr : info.argument()) mix_(static_cast<std::uint8_t>(chr));
+    return hash_;
+  };
+
+  /**
+   * @brief   Checks whether an entry holds the same error.
+   *
+   * @param   entry The published entry
+   * @param   info  The error to compare with
+   * @return        True if code and argument are equal
+   */
+  static bool matches(const Entry& entry, const ErrorInfo& info) noexcept {
+    return entry.info.code == info.code &&
+           entry.info.argument() == info.argument();
+  };
+};
+}  // namespace r2d2_errors::agent
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_DEDUP_HPP_
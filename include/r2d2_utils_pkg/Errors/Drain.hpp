@@ -0,0 +1,242 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_DRAIN_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_DRAIN_HPP_
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+#include "../Exceptions.hpp"
+
+namespace r2d2_errors::agent {
+constexpr std::size_t ERROR_SINK_BUFFER_LEN{4096};
+
+/**
+ * @brief   Stream buffer that collects output in a fixed buffer and writes it
+ *          to a C stream in blocks.
+ *
+ * @details Nothing is written until the buffer fills up or sync() is called,
+ *          so a burst of errors costs one write instead of one per line.
+ */
+class BufferedSink final : public std::streambuf {
+ private:
+  std::FILE* m_file;
+  std::array<char, ERROR_SINK_BUFFER_LEN> m_buffer{};
+
+ public:
+  /**
+   * @brief   Constructs a BufferedSink writing to the specified C stream.
+   *
+   * @param   file The destination stream (default: stderr)
+   */
+  explicit BufferedSink(std::FILE* file = stderr) : m_file{file} {
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+  };
+
+ protected:
+  int_type overflow(int_type chr) override {
+    if (sync() != 0) return traits_type::eof();
+    if (traits_type::eq_int_type(chr, traits_type::eof()))
+      return traits_type::not_eof(chr);
+    *pptr() = traits_type::to_char_type(chr);
+    pbump(1);
+    return chr;
+  };
+
+  int sync() override {
+    const auto size_{static_cast<std::size_t>(pptr() - pbase())};
+    const bool ok_{std::fwrite(pbase(), 1, size_, m_file) == size_};
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    return ok_ && std::fflush(m_file) == 0 ? 0 : -1;
+  };
+};
+
+/**
+ * @brief   Waits until a futex word changes from the expected value.
+ *
+ * @param   word     The futex word
+ * @param   expected The value to sleep on
+ * @param   timeout  The maximum wait
+ *
+ * @details May return early (spurious wake-up or signal); callers re-check.
+ */
+inline void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected,
+                       std::chrono::nanoseconds timeout) noexcept {
+  const auto ns_{timeout.count()};
+  const timespec ts_{static_cast<time_t>(ns_ / 1'000'000'000),
+                     static_cast<long>(ns_ % 1'000'000'000)};
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+          FUTEX_WAIT_PRIVATE, expected, &ts_, nullptr, 0);
+};
+
+/**
+ * @brief   Wakes one thread waiting on a futex word.
+ *
+ * @param   word The futex word
+ */
+inline void futex_wake(std::atomic<std::uint32_t>& word) noexcept {
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+          FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+};
+
+/**
+ * @brief   Background thread that drains the error record into a buffered
+ *          sink.
+ *
+ * @details While running, the drain is the only consumer of the error
+ *          record: PROCESS_ERROR_RECORD() just wakes it up and
+ *          FLUSH_ERROR_RECORD() waits until every pending error has been
+ *          written and flushed. The record itself stays bounded, so the
+ *          control thread only ever enqueues: wake() sets an atomic flag and
+ *          issues a futex wake-up only if the flag was clear, without taking
+ *          a lock. stop() (also called on destruction) flushes every pending
+ *          error before returning.
+ */
+class ErrorDrain final : public IErrorDrain {
+  static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t) &&
+                    std::atomic<std::uint32_t>::is_always_lock_free,
+                "ErrorDrain: the futex word must be a plain 32-bit atomic");
+
+ private:
+  std::chrono::nanoseconds m_interval;
+  BufferedSink m_sink;
+  std::ostream m_stream{&m_sink};
+  std::thread m_thread{};
+  std::atomic<std::uint32_t> m_signal{0};
+  std::atomic<bool> m_stop{false};
+  std::atomic<std::uint64_t> m_flushRequested{0};
+  std::mutex m_mutex{};
+  std::condition_variable m_doneCv{};
+  std::uint64_t m_flushDone{0};
+
+ public:
+  /**
+   * @brief   Constructs a stopped ErrorDrain.
+   *
+   * @param   interval Time between two drains when nobody wakes the thread
+   * @param   file     The destination stream (default: stderr)
+   */
+  explicit ErrorDrain(std::chrono::nanoseconds interval =
+                          std::chrono::milliseconds{100},
+                      std::FILE* file = stderr)
+      : m_interval{interval}, m_sink{file} {};
+
+  ErrorDrain(const ErrorDrain&) = delete;
+  ErrorDrain& operator=(const ErrorDrain&) = delete;
+
+  ~ErrorDrain() { stop(); };
+
+  /**
+   * @brief   Starts the drain thread and registers it as the error consumer.
+   *
+   * @return  True if the drain is running after the call
+   *
+   * @details Does nothing if this drain is already running. If another drain
+   *          is registered, the thread is not started.
+   */
+  bool start() {
+    if (m_thread.joinable()) return true;
+    IErrorDrain* expected_{nullptr};
+    if (!etc::errorDrain.compare_exchange_strong(expected_, this,
+                                                 std::memory_order_acq_rel))
+      return false;
+    m_stop = false;
+    m_thread = std::thread{&ErrorDrain::run, this};
+    return true;
+  };
+
+  /**
+   * @brief   Unregisters the drain, stops the thread and flushes every
+   *          pending error.
+   *
+   * @details The drain is unregistered first and stop() waits until no
+   *          thread still uses it, so it can be destroyed on return. Errors
+   *          recorded after the thread's last pass are written by a final
+   *          drain on the calling thread.
+   */
+  void stop() noexcept {
+    if (!m_thread.joinable()) return;
+    IErrorDrain* self_{this};
+    etc::errorDrain.compare_exchange_strong(self_, nullptr,
+                                            std::memory_order_seq_cst);
+    while (etc::drainUsers.load(std::memory_order_seq_cst) != 0)
+      std::this_thread::yield();
+    {
+      std::lock_guard lock_{m_mutex};
+      m_stop.store(true, std::memory_order_release);
+    }
+    signal();
+    m_thread.join();
+    report_errors(0, m_stream);
+    m_stream.flush();
+  };
+
+  /**
+   * @brief   Wakes the thread up to drain the record now.
+   */
+  void wake() noexcept override { signal(); };
+
+  /**
+   * @brief   Blocks until every error recorded before the call has been
+   *          written and flushed.
+   */
+  void flush() noexcept override {
+    std::unique_lock lock_{m_mutex};
+    if (!m_thread.joinable() || m_stop.load(std::memory_order_acquire))
+      return;
+    const std::uint64_t ticket_{
+        m_flushRequested.fetch_add(1, std::memory_order_release) + 1};
+    signal();
+    m_doneCv.wait(lock_, [&] { return m_flushDone >= ticket_; });
+  };
+
+ private:
+  void signal() noexcept {
+    if (m_signal.exchange(1, std::memory_order_release) == 0)
+      futex_wake(m_signal);
+  };
+
+  void run() noexcept {
+    while (true) {
+      if (m_signal.load(std::memory_order_acquire) == 0)
+        futex_wait(m_signal, 0, m_interval);
+      m_signal.store(0, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const bool stop_{m_stop.load(std::memory_order_acquire)};
+      const std::uint64_t ticket_{
+          m_flushRequested.load(std::memory_order_acquire)};
+      bool force_{stop_};
+      {
+        std::lock_guard lock_{m_mutex};
+        force_ = force_ || ticket_ > m_flushDone;
+      }
+
+      report_errors(
+          force_ ? 0 : etc::emitPeriodNs.load(std::memory_order_relaxed),
+          m_stream);
+      m_stream.flush();
+
+      {
+        std::lock_guard lock_{m_mutex};
+        m_flushDone = ticket_;
+      }
+      m_doneCv.notify_all();
+      if (stop_) return;
+    }
+  };
+};
+}  // namespace r2d2_errors::agent
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_DRAIN_HPP_
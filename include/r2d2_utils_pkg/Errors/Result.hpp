@@ -0,0 +1,134 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_RESULT_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_RESULT_HPP_
+
+#include <cassert>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "Code.hpp"
+
+namespace r2d2_errors {
+/**
+ * @brief   Tag carrying the error code of a failed Result.
+ */
+struct Failure {
+  ErrorCode code;
+};
+
+/**
+ * @brief   Creates a failure tag for the specified error code.
+ *
+ * @param   code The error code
+ * @return       The failure tag, convertible to any Result
+ */
+constexpr Failure fail(ErrorCode code) noexcept { return Failure{code}; };
+
+/**
+ * @brief   Expected-like holder of either a value or an error code.
+ *
+ * @tparam  T The value type
+ *
+ * @details Used by the try_ API variants to report misses without throwing.
+ *          Accessing the value of a failed Result is a precondition violation
+ *          checked by assert.
+ */
+template <typename T>
+class [[nodiscard]] Result {
+ private:
+  std::optional<T> m_value{};
+  ErrorCode m_error{ErrorCode::UNKNOWN};
+
+ public:
+  /**
+   * @brief   Constructs a successful Result.
+   *
+   * @param   value The held value
+   */
+  Result(T value) noexcept(std::is_nothrow_move_constructible_v<T>)
+      : m_value{std::move(value)} {};
+
+  /**
+   * @brief   Constructs a failed Result.
+   *
+   * @param   failure The failure tag carrying the error code
+   */
+  Result(Failure failure) noexcept : m_error{failure.code} {};
+
+  [[nodiscard]] bool has_value() const noexcept {
+    return m_value.has_value();
+  };
+  explicit operator bool() const noexcept { return has_value(); };
+
+  /**
+   * @brief   Gets the error code of a failed Result.
+   *
+   * @return  The error code (ErrorCode::UNKNOWN if the Result holds a value)
+   */
+  [[nodiscard]] ErrorCode error() const noexcept { return m_error; };
+
+  [[nodiscard]] T& value() & noexcept {
+    assert(has_value());
+    return *m_value;
+  };
+  [[nodiscard]] const T& value() const& noexcept {
+    assert(has_value());
+    return *m_value;
+  };
+  [[nodiscard]] T&& value() && noexcept {
+    assert(has_value());
+    return std::move(*m_value);
+  };
+
+  T& operator*() & noexcept { return value(); };
+  const T& operator*() const& noexcept { return value(); };
+  T&& operator*() && noexcept { return std::move(*this).value(); };
+  T* operator->() noexcept { return &value(); };
+  const T* operator->() const noexcept { return &value(); };
+
+  /**
+   * @brief   Gets the value or a fallback.
+   *
+   * @param   fallback The value returned if the Result failed
+   * @return           The held value or the fallback
+   */
+  template <typename U>
+  [[nodiscard]] T value_or(U&& fallback) const& {
+    return has_value() ? *m_value : static_cast<T>(std::forward<U>(fallback));
+  };
+  template <typename U>
+  [[nodiscard]] T value_or(U&& fallback) && {
+    return has_value() ? std::move(*m_value)
+                       : static_cast<T>(std::forward<U>(fallback));
+  };
+};
+
+/**
+ * @brief   Result specialization holding a reference.
+ *
+ * @tparam  T The referenced type
+ */
+template <typename T>
+class [[nodiscard]] Result<T&> {
+ private:
+  T* m_ptr{nullptr};
+  ErrorCode m_error{ErrorCode::UNKNOWN};
+
+ public:
+  Result(T& value) noexcept : m_ptr{&value} {};
+  Result(Failure failure) noexcept : m_error{failure.code} {};
+
+  [[nodiscard]] bool has_value() const noexcept { return m_ptr != nullptr; };
+  explicit operator bool() const noexcept { return has_value(); };
+  [[nodiscard]] ErrorCode error() const noexcept { return m_error; };
+
+  [[nodiscard]] T& value() const noexcept {
+    assert(has_value());
+    return *m_ptr;
+  };
+  T& operator*() const noexcept { return value(); };
+  T* operator->() const noexcept { return &value(); };
+};
+}  // namespace r2d2_errors
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_RESULT_HPP_
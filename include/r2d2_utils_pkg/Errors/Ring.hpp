@@ -0,0 +1,129 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_RING_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_RING_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace r2d2_errors::agent {
+constexpr std::size_t ERROR_RECORD_CAPACITY{256};
+
+/**
+ * @brief   Bounded multi-producer single-consumer ring of fixed-size error
+ *          record slots.
+ *
+ * @tparam  Capacity Number of slots (must be a power of two)
+ * @tparam  Record   Trivially copyable record type stored in each slot
+ *
+ * @details All storage is allocated with the ring itself. Producers claim a
+ *          slot with a single fetch_add and a single CAS, so push() is
+ *          wait-free and never allocates. A slot that is still occupied by an
+ *          undrained record is not overwritten: the new record is dropped
+ *          and counted as an overflow. Only one thread may call drain() at a
+ *          time.
+ */
+template <std::size_t Capacity, typename Record>
+class ErrorRing {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two!");
+  static_assert(std::is_trivially_copyable_v<Record>,
+                "Record must be trivially copyable!");
+
+ private:
+  enum SlotState : std::uint8_t { FREE = 0, WRITING, READY };
+
+  struct Slot {
+    std::atomic<std::uint8_t> state{FREE};
+    Record record{};
+  };
+
+  std::array<Slot, Capacity> m_slots{};
+  alignas(64) std::atomic<std::size_t> m_head{0};
+  alignas(64) std::atomic<std::size_t> m_pending{0};
+  std::atomic<std::size_t> m_overflow{0};
+  std::size_t m_tail{0};
+
+ public:
+  /**
+   * @brief   Copies a record into the next slot.
+   *
+   * @param   record The record to store
+   * @return         True if the record was stored, false on overflow
+   */
+  bool push(const Record& record) noexcept {
+    Slot& slot_{m_slots[m_head.fetch_add(1, std::memory_order_relaxed) &
+                        (Capacity - 1)]};
+    std::uint8_t expected_{FREE};
+    if (!slot_.state.compare_exchange_strong(expected_, WRITING,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+      m_overflow.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    slot_.record = record;
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+    slot_.state.store(READY, std::memory_order_release);
+    return true;
+  };
+
+  /**
+   * @brief   Consumes every ready record in slot order.
+   *
+   * @tparam  Func Callable taking a const Record&
+   * @param   func The callback invoked for each record
+   * @return       The number of consumed records
+   *
+   * @details Scans one full lap starting after the last consumed slot. Slots
+   *          that are still being written are skipped and picked up by the
+   *          next call.
+   */
+  template <typename Func>
+  std::size_t drain(Func&& func) {
+    const std::size_t start_{m_tail};
+    std::size_t count_{0};
+    for (std::size_t i = 0; i < Capacity; ++i) {
+      const std::size_t index_{(start_ + i) & (Capacity - 1)};
+      Slot& slot_{m_slots[index_]};
+      if (slot_.state.load(std::memory_order_acquire) != READY) continue;
+      func(std::as_const(slot_.record));
+      slot_.state.store(FREE, std::memory_order_release);
+      m_pending.fetch_sub(1, std::memory_order_relaxed);
+      m_tail = index_ + 1;
+      ++count_;
+    }
+    return count_;
+  };
+
+  /**
+   * @brief   Checks whether there are undrained records.
+   *
+   * @return  True if at least one record is waiting
+   */
+  [[nodiscard]] bool empty() const noexcept {
+    return m_pending.load(std::memory_order_acquire) == 0;
+  };
+
+  /**
+   * @brief   Takes the number of dropped records since the last call.
+   *
+   * @return  The overflow count, reset to zero
+   */
+  std::size_t take_overflow() noexcept {
+    return m_overflow.exchange(0, std::memory_order_relaxed);
+  };
+
+  /**
+   * @brief   Gets the number of dropped records without resetting it.
+   *
+   * @return  The overflow count
+   */
+  [[nodiscard]] std::size_t overflow() const noexcept {
+    return m_overflow.load(std::memory_order_relaxed);
+  };
+};
+}  // namespace r2d2_errors::agent
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_RING_HPP_
@@ -1,87 +1,74 @@
 #ifndef INCLUDE_R2D2_UTILS_PKG_EXCEPTIONS_HPP_
 #define INCLUDE_R2D2_UTILS_PKG_EXCEPTIONS_HPP_
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <exception>
 #include <iostream>
-#include <queue>
+#include <stdexcept>
 
+#include "Errors/Code.hpp"
+#include "Errors/Dedup.hpp"
+#include "Errors/Ring.hpp"
 #include "Logging/Console.hpp"
 
 #define CHECK_FOR_ERROR_RECORD() r2d2_errors::agent::check()
 #define RECORD_ERROR(error) r2d2_errors::agent::record(error)
 #define PRINT_ERROR(msg) r2d2_errors::agent::print_error(msg)
 #define PROCESS_ERROR_RECORD() r2d2_errors::agent::process_errors()
+#define FLUSH_ERROR_RECORD() r2d2_errors::agent::flush_errors()
 
 namespace r2d2_errors {
 /**
- * @brief   Base class for error types that concatenate multiple strings into a
- *          message.
+ * @brief   Base class for error types that carry a structured error code and
+ *          format their message lazily.
  *
  * @tparam  Error The underlying error type to inherit from
+ * @tparam  code  The error code describing this error type
  *
- * @details Provides functionality to create error messages by concatenating
- *          multiple string arguments.
+ * @details Construction only copies the argument into an inline ErrorInfo, so
+ *          creating, recording and counting an error never allocates. The
+ *          human-readable message is formatted into an inline buffer on the
+ *          first call to what().
  */
-template <typename Error>
-class BaseError : public Error {
- protected:
-  /**
-   * @brief   Constructs a BaseError with a concatenated message from multiple
-   *          strings.
-   *
-   * @tparam  String Variadic string types
-   * @param   str    Variadic list of strings to concatenate into the error
-   *                 message
-   */
-  template <typename... String>
-  explicit BaseError(String&&... str)
-      : Error{createMessage(std::forward<String>(str)...)} {};
-
+template <typename Error, ErrorCode code>
+class BaseError : public Error, public IStructuredError {
  private:
+  ErrorInfo m_info;
+  mutable std::array<char, ERROR_WHAT_LEN> m_what;
+  mutable bool m_hasWhat{false};
+
+ protected:
   /**
-   * @brief   Creates a concatenated error message from multiple string
-   *          arguments.
-   *
-   * @tparam  String Variadic string types
-   * @param   str    Variadic list of strings to concatenate
-   * @return         A concatenated string containing all input strings
+   * @brief   Constructs a BaseError with the specified argument.
    *
-   * @details Pre-allocates memory based on total string sizes and appends all
-   *          strings in order.
+   * @param   arg The key or name the error refers to
    */
-  template <typename... String>
-  static std::string createMessage(String&&... str) noexcept {
-    std::string result_;
-    result_.reserve((string_size(str) + ...));
-    (result_.append(std::forward<String>(str)), ...);
-    return result_;
-  };
+  explicit BaseError(std::string_view arg) : Error{""}, m_info{code, arg} {};
 
+ public:
   /**
-   * @brief   Calculates the size of a C-style array string
-   *          (excluding null terminator).
+   * @brief   Gets the error message, formatting it on first access.
    *
-   * @tparam  T   Element type
-   * @tparam  N   Array size
-   * @param   arr Reference to the array
-   * @return      The size of the string (N - 1)
+   * @return  The null-terminated error message
    */
-  template <typename T, size_t N>
-  static constexpr size_t string_size(const T (&)[N]) noexcept {
-    return N - 1;
+  [[nodiscard]] const char* what() const noexcept override {
+    if (!m_hasWhat) {
+      m_info.format(m_what.data(), m_what.size());
+      m_hasWhat = true;
+    }
+    return m_what.data();
   };
 
   /**
-   * @brief   Calculates the size of a string-like object.
-   *
-   * @tparam  T   String type (must have std::size() support)
-   * @param   str The string object
+   * @brief   Gets the structured representation of the error.
    *
-   * @return  The size of the string
+   * @return  Reference to the error code and argument
    */
-  template <typename T>
-  static constexpr size_t string_size(T&& str) noexcept {
-    return std::size(str);
+  [[nodiscard]] const ErrorInfo& info() const noexcept override {
+    return m_info;
   };
 };
 }  // namespace r2d2_errors
@@ -98,32 +85,116 @@ struct RecordNotEmptyError final : public std::runtime_error {
       : std::runtime_error("ErrorRecord has errors!") {};
 };
 
+/**
+ * @brief   Interface of a background consumer that owns the error record.
+ *
+ * @details While a drain is registered, process_errors() and flush_errors()
+ *          delegate to it instead of printing on the calling thread.
+ */
+class IErrorDrain {
+ public:
+  virtual void wake() noexcept = 0;
+  virtual void flush() noexcept = 0;
+
+ protected:
+  ~IErrorDrain() = default;
+};
+
 namespace etc {
-inline std::queue<std::string> errorQueue{};
-}
+inline std::atomic<IErrorDrain*> errorDrain{nullptr};
+inline std::atomic<std::uint32_t> drainUsers{0};
+inline std::atomic_flag consuming = ATOMIC_FLAG_INIT;
+inline ErrorRing<ERROR_RECORD_CAPACITY, ErrorInfo> errorRing{};
+inline ErrorTable<ERROR_TABLE_CAPACITY, ERROR_TABLE_PROBES> errorTable{};
+inline std::atomic<std::int64_t> emitPeriodNs{1'000'000'000};
+
+/**
+ * @brief   Gets the current steady-clock time in nanoseconds.
+ *
+ * @return  Nanoseconds since the steady-clock epoch
+ */
+inline std::int64_t now_ns() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+};
+
+/**
+ * @brief   Calls a function on the registered drain, if any.
+ *
+ * @tparam  Func Callable taking an IErrorDrain&
+ * @param   func The function
+ * @return       True if a drain was registered
+ *
+ * @details The caller is counted in drainUsers for the duration of the call,
+ *          so ErrorDrain::stop() can wait until nobody uses the drain it has
+ *          just unregistered.
+ */
+template <typename Func>
+bool with_drain(Func&& func) noexcept {
+  drainUsers.fetch_add(1, std::memory_order_seq_cst);
+  auto* drain_{errorDrain.load(std::memory_order_seq_cst)};
+  if (drain_) func(*drain_);
+  drainUsers.fetch_sub(1, std::memory_order_release);
+  return drain_ != nullptr;
+};
+}  // namespace etc
+
+/**
+ * @brief   Sets the minimum time between two reports of the same error.
+ *
+ * @param   period The emit period (non-positive reports on every call)
+ */
+inline void set_emit_period(std::chrono::nanoseconds period) noexcept {
+  etc::emitPeriodNs.store(period.count(), std::memory_order_relaxed);
+};
+
 /**
- * @brief   Checks if there are any errors in the error queue.
+ * @brief   Checks if there are any errors in the error record.
  *
- * @return  True if errors exist, false otherwise
+ * @return  True if errors exist or some were dropped, false otherwise
  */
-inline bool has_errors() noexcept { return !etc::errorQueue.empty(); };
+inline bool has_errors() noexcept {
+  return !etc::errorTable.empty() || !etc::errorRing.empty() ||
+         etc::errorRing.overflow() > 0;
+};
 
 /**
  * @brief   Checks for errors and throws RecordNotEmptyError if any exist.
  *
- * @throws  RecordNotEmptyError if the error queue is not empty
+ * @throws  RecordNotEmptyError if the error record is not empty
  */
 inline void check() {
   if (has_errors()) throw RecordNotEmptyError{};
 };
 
 /**
- * @brief   Records an exception in the error queue.
+ * @brief   Records a structured error in the error record.
+ *
+ * @param   info The error to record
+ *
+ * @details Wait-free and allocation-free. Repeated errors with the same code
+ *          and argument are deduplicated into one counted entry. Errors that
+ *          find no free entry go to the ring and are dropped (but counted) if
+ *          the ring is full as well.
+ */
+inline void record(const ErrorInfo& info) noexcept {
+  if (!etc::errorTable.record(info, etc::now_ns())) etc::errorRing.push(info);
+};
+
+/**
+ * @brief   Records an exception in the error record.
  *
  * @param   e The exception to record
+ *
+ * @details Structured errors are recorded by code and argument without
+ *          formatting their message. Other exceptions are recorded as
+ *          ErrorCode::UNKNOWN with their (truncated) what() message.
  */
 inline void record(const std::exception& e) noexcept {
-  etc::errorQueue.emplace(e.what());
+  if (const auto* structured_{dynamic_cast<const IStructuredError*>(&e)})
+    return record(structured_->info());
+  record(ErrorInfo{ErrorCode::UNKNOWN, e.what()});
 };
 
 /**
@@ -136,15 +207,74 @@ inline void print_error(std::string_view err_msg) noexcept {
 };
 
 /**
- * @brief   Processes all errors in the queue by printing and removing them.
+ * @brief   Prints a structured error.
+ *
+ * @param   info The error to print
+ * @param   os   The output stream (default: stderr)
+ *
+ * @details The message is streamed piecewise without building a string.
+ */
+inline void print_error(const ErrorInfo& info,
+                        std::ostream& os = std::cerr) noexcept {
+  os << RED("Got exception: " << info) << "\n";
+};
+
+/**
+ * @brief   Prints a summary of repeated errors.
  *
- * @details Prints each error message and removes it from the queue until empty.
+ * @param   summary The error summary to print
+ * @param   os      The output stream (default: stderr)
+ */
+inline void print_error(const ErrorSummary& summary,
+                        std::ostream& os = std::cerr) noexcept {
+  os << RED("Got exception: " << summary) << "\n";
+};
+
+/**
+ * @brief   Reports errors in the record by printing and removing them.
+ *
+ * @param   periodNs Minimum time between two reports of the same error
+ * @param   os       The output stream (default: stderr)
+ *
+ * @details Meant for a single consumer thread. A call made while another
+ *          thread is reporting returns without doing anything; the errors
+ *          are left to that thread or to the next call.
+ */
+inline void report_errors(std::int64_t periodNs,
+                          std::ostream& os = std::cerr) noexcept {
+  if (etc::consuming.test_and_set(std::memory_order_acquire)) return;
+  etc::errorTable.report(etc::now_ns(), periodNs, [&os](const auto& summary) {
+    print_error(summary, os);
+  });
+  etc::errorRing.drain([&os](const ErrorInfo& info) { print_error(info, os); });
+  if (const auto dropped_{etc::errorRing.take_overflow()}; dropped_ > 0)
+    os << RED("Dropped " << dropped_ << " error(s)!") << "\n";
+  etc::consuming.clear(std::memory_order_release);
+};
+
+/**
+ * @brief   Processes errors in the record by printing and removing them.
+ *
+ * @details Must be called from a single consumer thread. A new error is
+ *          printed on the next call; repeats of the same error are printed as
+ *          one summary at most once per emit period (see set_emit_period()).
+ *          If a background drain is running, only wakes it up.
  */
 inline void process_errors() noexcept {
-  while (has_errors()) {
-    print_error(etc::errorQueue.front());
-    etc::errorQueue.pop();
-  }
+  if (etc::with_drain([](IErrorDrain& drain) { drain.wake(); })) return;
+  report_errors(etc::emitPeriodNs.load(std::memory_order_relaxed));
+};
+
+/**
+ * @brief   Prints every pending error regardless of the emit period.
+ *
+ * @details Must be called from a single consumer thread, e.g. on shutdown.
+ *          If a background drain is running, blocks until it has written and
+ *          flushed every pending error.
+ */
+inline void flush_errors() noexcept {
+  if (etc::with_drain([](IErrorDrain& drain) { drain.flush(); })) return;
+  report_errors(0);
 };
 }  // namespace r2d2_errors::agent
 
@@ -152,14 +282,13 @@ namespace r2d2_errors::collections {
 /**
  * @brief   Exception thrown when a name is not found in a collection.
  */
-struct NameError final : public BaseError<std::out_of_range> {
+struct NameError final : public BaseError<std::out_of_range, ErrorCode::NAME> {
   /**
    * @brief   Constructs a NameError for the specified name.
    *
    * @param   name The name that was not found
    */
-  explicit NameError(std::string_view name)
-      : BaseError("Name \"", name, "\" is not found!") {};
+  explicit NameError(std::string_view name) : BaseError{name} {};
 };
 }  // namespace r2d2_errors::collections
 
@@ -167,40 +296,41 @@ namespace r2d2_errors::json {
 /**
  * @brief   Exception thrown when a JSON file is not found.
  */
-struct FileNotFoundError final : public BaseError<std::runtime_error> {
+struct FileNotFoundError final
+    : public BaseError<std::runtime_error, ErrorCode::FILE_NOT_FOUND> {
   /**
    * @brief   Constructs a FileNotFoundError for the specified file name.
    *
    * @param   fileName The name of the file that was not found
    */
   explicit FileNotFoundError(std::string_view fileName)
-      : BaseError("File \"", fileName, ".json\"is not found!") {};
+      : BaseError{fileName} {};
 };
 
 /**
  * @brief   Exception thrown when a JSON parameter is not found.
  */
-struct ParameterError final : public BaseError<std::runtime_error> {
+struct ParameterError final
+    : public BaseError<std::runtime_error, ErrorCode::PARAMETER> {
   /**
    * @brief   Constructs a ParameterError for the specified parameter key.
    *
    * @param   key The parameter key that was not found
    */
-  explicit ParameterError(std::string_view key)
-      : BaseError("Parameter \"", key, "\" is not found!") {};
+  explicit ParameterError(std::string_view key) : BaseError{key} {};
 };
 
 /**
  * @brief   Exception thrown when a JSON object is not found during parsing.
  */
-struct ObjectParseError final : public BaseError<std::runtime_error> {
+struct ObjectParseError final
+    : public BaseError<std::runtime_error, ErrorCode::OBJECT_PARSE> {
   /**
    * @brief   Constructs an ObjectParseError for the specified object key.
    *
    * @param   key The object key that was not found
    */
-  explicit ObjectParseError(std::string_view key)
-      : BaseError("Object \"", key, "\" is not found!") {};
+  explicit ObjectParseError(std::string_view key) : BaseError{key} {};
 };
 }  // namespace r2d2_errors::json
 #endif  // INCLUDE_R2D2_UTILS_PKG_EXCEPTIONS_HPP_
@@ -0,0 +1,417 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_EXECUTOR_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_EXECUTOR_HPP_
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Logging/Scope.hpp"
+
+namespace r2d2_loop {
+using r2d2_latency::Histogram;
+using r2d2_latency::LatencyStats;
+
+/**
+ * @brief   Reads the clock used for the loop deadlines.
+ *
+ * @return  CLOCK_MONOTONIC time in nanoseconds
+ */
+inline std::int64_t now_ns() noexcept {
+  timespec ts_{};
+  clock_gettime(CLOCK_MONOTONIC, &ts_);
+  return static_cast<std::int64_t>(ts_.tv_sec) * 1'000'000'000 + ts_.tv_nsec;
+};
+
+/**
+ * @brief   Sleeps until an absolute CLOCK_MONOTONIC time.
+ *
+ * @param   deadlineNs The wake-up time in nanoseconds
+ */
+inline void sleep_until_ns(std::int64_t deadlineNs) noexcept {
+  const timespec ts_{static_cast<time_t>(deadlineNs / 1'000'000'000),
+                     static_cast<long>(deadlineNs % 1'000'000'000)};
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts_, nullptr) ==
+         EINTR) {
+  }
+};
+
+/**
+ * @brief   Configuration of a LoopExecutor.
+ */
+struct LoopOptions {
+  /// Cycle period
+  std::chrono::nanoseconds period{std::chrono::milliseconds{10}};
+  /// CPU to pin the loop thread to, or -1 to leave it unpinned
+  int cpu{-1};
+  /// SCHED_FIFO priority (1-99), or 0 to keep the default scheduler
+  int priority{0};
+  /// Lock the process memory (mlockall) before the first cycle
+  bool lockMemory{false};
+};
+
+/**
+ * @brief   Real-time settings that were actually applied to the loop thread.
+ */
+struct RtStatus {
+  bool pinned{false};
+  bool realtime{false};
+  bool locked{false};
+};
+
+/**
+ * @brief   Statistics of one stage, in nanoseconds.
+ *
+ * @details exec is the stage run time, jitter the delay between the cycle
+ *          deadline and the stage start, missed the number of cycles in
+ *          which the stage finished after the next deadline.
+ */
+struct StageStats {
+  std::string_view name{};
+  LatencyStats exec{};
+  LatencyStats jitter{};
+  std::uint64_t missed{};
+};
+
+/**
+ * @brief   Statistics of the whole loop.
+ *
+ * @details wakeup is the delay between the deadline and the return from the
+ *          sleep, overruns the number of cycles that ended after the next
+ *          deadline and skipped the number of periods dropped to catch up.
+ */
+struct LoopStats {
+  std::uint64_t cycles{};
+  std::uint64_t overruns{};
+  std::uint64_t skipped{};
+  LatencyStats wakeup{};
+};
+
+/**
+ * @brief   Runs registered stages at a fixed period.
+ *
+ * @details Each cycle sleeps with clock_nanosleep() until an absolute
+ *          deadline, so the period does not drift with the stage run times,
+ *          then runs every stage in registration order. A cycle that ends
+ *          more than one period late drops the periods it missed instead of
+ *          running them back to back.
+ *
+ *          The loop thread is the only writer of the statistics, which are
+ *          kept in r2d2_latency histograms and relaxed atomic counters, so
+ *          stats() and report() can be called from any thread while the loop
+ *          is running without ever blocking it.
+ *
+ *          Pinning, SCHED_FIFO and mlockall() are applied when permitted;
+ *          a refusal (e.g. EPERM without CAP_SYS_NICE) is not an error and
+ *          rt_status() tells what took effect.
+ *
+ *          Usage:
+ *          @code
+ *          r2d2_loop::LoopExecutor loop_{{std::chrono::milliseconds{2}, 3}};
+ *          loop_.add("joints", [&] { joints_.call_each(&Joint::update); });
+ *          loop_.start();
+ *          @endcode
+ */
+class LoopExecutor {
+ private:
+  struct Stage {
+    std::string name;
+    std::function<void()> fn;
+    Histogram exec{};
+    Histogram jitter{};
+    std::atomic<std::uint64_t> missed{0};
+  };
+
+  const LoopOptions m_options;
+  std::vector<std::unique_ptr<Stage>> m_stages{};
+  Histogram m_wakeup{};
+  std::atomic<std::uint64_t> m_cycles{0};
+  std::atomic<std::uint64_t> m_overruns{0};
+  std::atomic<std::uint64_t> m_skipped{0};
+  std::atomic<bool> m_running{false};
+  std::atomic<bool> m_stop{false};
+  std::atomic<bool> m_pinned{false};
+  std::atomic<bool> m_realtime{false};
+  std::atomic<bool> m_locked{false};
+  std::thread m_thread{};
+  std::exception_ptr m_error{};
+
+  /**
+   * @brief   Increments a counter only written by the loop thread.
+   */
+  static void bump(std::atomic<std::uint64_t>& counter,
+                   std::uint64_t by = 1) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + by,
+                  std::memory_order_relaxed);
+  };
+
+  /**
+   * @brief   Runs the loop once m_running has been claimed by the caller.
+   */
+  void run_claimed() {
+    setup_thread();
+    try {
+      loop();
+    } catch (...) {
+      m_running = false;
+      throw;
+    }
+    m_running = false;
+  };
+
+  /**
+   * @brief   Applies the real-time options to the calling thread.
+   */
+  void setup_thread() noexcept {
+    if (m_options.cpu >= 0) {
+      cpu_set_t set_;
+      CPU_ZERO(&set_);
+      CPU_SET(m_options.cpu, &set_);
+      m_pinned = pthread_setaffinity_np(pthread_self(), sizeof(set_),
+                                        &set_) == 0;
+    }
+    if (m_options.priority > 0) {
+      sched_param param_{};
+      param_.sched_priority = m_options.priority;
+      m_realtime =
+          pthread_setschedparam(pthread_self(), SCHED_FIFO, &param_) == 0;
+    }
+    if (m_options.lockMemory)
+      m_locked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+  };
+
+  /**
+   * @brief   Runs cycles until stop() is called.
+   */
+  void loop() {
+    const std::int64_t period_{m_options.period.count()};
+    std::int64_t deadline_{now_ns() + period_};
+    while (!m_stop.load(std::memory_order_relaxed)) {
+      sleep_until_ns(deadline_);
+      const std::int64_t next_{deadline_ + period_};
+      std::int64_t start_{now_ns()};
+      m_wakeup.record(static_cast<std::uint64_t>(
+          std::max<std::int64_t>(0, start_ - deadline_)));
+      for (auto& stage_ : m_stages) {
+        stage_->fn();
+        const std::int64_t end_{now_ns()};
+        stage_->exec.record(static_cast<std::uint64_t>(end_ - start_));
+        stage_->jitter.record(static_cast<std::uint64_t>(
+            std::max<std::int64_t>(0, start_ - deadline_)));
+        if (end_ > next_) bump(stage_->missed);
+        start_ = end_;
+      }
+      bump(m_cycles);
+      deadline_ = next_;
+      if (start_ > deadline_) {
+        bump(m_overruns);
+        const std::int64_t behind_{(start_ - deadline_) / period_};
+        if (behind_ > 0) {
+          bump(m_skipped, static_cast<std::uint64_t>(behind_));
+          deadline_ += behind_ * period_;
+        }
+      }
+    }
+  };
+
+ public:
+  /**
+   * @brief   Constructs a LoopExecutor.
+   *
+   * @param   options The loop configuration
+   * @throws  std::invalid_argument If the period is not positive, the
+   *                                priority is out of the SCHED_FIFO range
+   *                                or the CPU is not below CPU_SETSIZE
+   */
+  explicit LoopExecutor(const LoopOptions& options) : m_options{options} {
+    if (m_options.period.count() <= 0)
+      throw std::invalid_argument{"LoopExecutor: period must be positive"};
+    if (m_options.cpu >= CPU_SETSIZE)
+      throw std::invalid_argument{"LoopExecutor: invalid cpu"};
+    if (m_options.priority != 0 &&
+        (m_options.priority < sched_get_priority_min(SCHED_FIFO) ||
+         m_options.priority > sched_get_priority_max(SCHED_FIFO)))
+      throw std::invalid_argument{"LoopExecutor: invalid priority"};
+  };
+  LoopExecutor(const LoopExecutor&) = delete;
+  LoopExecutor& operator=(const LoopExecutor&) = delete;
+  ~LoopExecutor() {
+    m_stop = true;
+    if (m_thread.joinable()) m_thread.join();
+  };
+
+  /**
+   * @brief   Registers a stage, run after the stages added before it.
+   *
+   * @param   name The stage name
+   * @param   fn   The stage function
+   * @return       The stage index, usable with stats()
+   * @throws  std::logic_error      If the loop is running
+   * @throws  std::invalid_argument If a stage has the same name
+   */
+  std::size_t add(std::string name, std::function<void()> fn) {
+    if (m_running) throw std::logic_error{"LoopExecutor: loop is running"};
+    for (const auto& stage_ : m_stages)
+      if (stage_->name == name)
+        throw std::invalid_argument{"LoopExecutor: duplicate stage " + name};
+    m_stages.push_back(std::make_unique<Stage>());
+    m_stages.back()->name = std::move(name);
+    m_stages.back()->fn = std::move(fn);
+    return m_stages.size() - 1;
+  };
+
+  /**
+   * @brief   Runs the loop in the calling thread until stop() is called.
+   *
+   * @throws  std::logic_error If the loop is already running
+   * @details Exceptions thrown by a stage end the loop and propagate.
+   */
+  void run() {
+    if (m_running.exchange(true))
+      throw std::logic_error{"LoopExecutor: loop is running"};
+    m_stop = false;
+    run_claimed();
+  };
+
+  /**
+   * @brief   Runs the loop in a new thread.
+   *
+   * @throws  std::logic_error If the loop is already running
+   */
+  void start() {
+    if (m_thread.joinable() || m_running.exchange(true))
+      throw std::logic_error{"LoopExecutor: loop is running"};
+    // Reset before the thread exists, so an early stop() is not lost
+    m_stop = false;
+    m_error = nullptr;
+    m_thread = std::thread{[this] {
+      try {
+        run_claimed();
+      } catch (...) {
+        m_error = std::current_exception();
+      }
+    }};
+  };
+
+  /**
+   * @brief   Stops the loop after the current cycle.
+   *
+   * @throws  Any exception that ended a loop started with start()
+   * @details Called from a stage, it only requests the stop.
+   */
+  void stop() {
+    m_stop = true;
+    if (!m_thread.joinable() ||
+        m_thread.get_id() == std::this_thread::get_id())
+      return;
+    m_thread.join();
+    if (m_error) std::rethrow_exception(std::exchange(m_error, nullptr));
+  };
+
+  [[nodiscard]] bool running() const noexcept { return m_running; };
+  [[nodiscard]] std::size_t size() const noexcept { return m_stages.size(); };
+  [[nodiscard]] const LoopOptions& options() const noexcept {
+    return m_options;
+  };
+
+  /**
+   * @brief   Gets the real-time settings applied by the loop thread.
+   *
+   * @return  The applied settings
+   */
+  [[nodiscard]] RtStatus rt_status() const noexcept {
+    return {m_pinned, m_realtime, m_locked};
+  };
+
+  /**
+   * @brief   Gets the statistics of a stage.
+   *
+   * @param   index The stage index returned by add()
+   * @return        The statistics since the loop was created
+   */
+  [[nodiscard]] StageStats stats(std::size_t index) const {
+    const Stage& stage_{*m_stages.at(index)};
+    std::array<std::uint64_t, r2d2_latency::HISTOGRAM_BUCKETS> exec_{},
+        jitter_{};
+    stage_.exec.merge_into(exec_);
+    stage_.jitter.merge_into(jitter_);
+    return {stage_.name, r2d2_latency::stats_of(exec_, 1.0),
+            r2d2_latency::stats_of(jitter_, 1.0),
+            stage_.missed.load(std::memory_order_relaxed)};
+  };
+
+  /**
+   * @brief   Gets the statistics of the whole loop.
+   *
+   * @return  The statistics since the loop was created
+   */
+  [[nodiscard]] LoopStats stats() const {
+    std::array<std::uint64_t, r2d2_latency::HISTOGRAM_BUCKETS> wakeup_{};
+    m_wakeup.merge_into(wakeup_);
+    return {m_cycles.load(std::memory_order_relaxed),
+            m_overruns.load(std::memory_order_relaxed),
+            m_skipped.load(std::memory_order_relaxed),
+            r2d2_latency::stats_of(wakeup_, 1.0)};
+  };
+
+  /**
+   * @brief   Formats one report line for the loop and one per stage.
+   *
+   * @tparam  Sink Callable taking a const std::string&
+   * @param   sink The line sink
+   *
+   * @details Times are in microseconds. Colors come from the
+   *          ColorPreset::RESULT preset, like r2d2_latency::report().
+   */
+  template <typename Sink>
+  void report(Sink&& sink) const {
+    using r2d2_console::ColorPreset;
+    constexpr auto color_{r2d2_console::paint(ColorPreset::RESULT)};
+    std::ostringstream oss_;
+    auto field_ = [&](const char* label, auto value, const char* unit,
+                      const char* sep) {
+      oss_ << color_.arg.name << label << " = " << color_.arg.value << value
+           << unit << ANSI_RESET << sep;
+    };
+    const auto loop_{stats()};
+    oss_ << color_.name << "loop" << ANSI_RESET << ": ";
+    field_("n", loop_.cycles, "", ", ");
+    field_("overruns", loop_.overruns, "", ", ");
+    field_("skipped", loop_.skipped, "", ", ");
+    field_("wakeup p99", loop_.wakeup.p99 / 1e3, " us", ", ");
+    field_("wakeup max", loop_.wakeup.max / 1e3, " us", "");
+    sink(oss_.str());
+    for (std::size_t i = 0; i < m_stages.size(); ++i) {
+      const auto stage_{stats(i)};
+      oss_.str("");
+      oss_ << color_.name << stage_.name << ANSI_RESET << ": ";
+      field_("n", stage_.exec.count, "", ", ");
+      field_("missed", stage_.missed, "", ", ");
+      field_("p50", stage_.exec.p50 / 1e3, " us", ", ");
+      field_("p99", stage_.exec.p99 / 1e3, " us", ", ");
+      field_("max", stage_.exec.max / 1e3, " us", ", ");
+      field_("jitter p99", stage_.jitter.p99 / 1e3, " us", "");
+      sink(oss_.str());
+    }
+  };
+};
+}  // namespace r2d2_loop
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_EXECUTOR_HPP_
@@ -0,0 +1,306 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_FITTING_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_FITTING_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Polynome.hpp"
+
+namespace r2d2_fit {
+/**
+ * @brief   Fills the regressor of a polynomial in Horner order.
+ *
+ * @tparam  T    Floating-point type
+ * @param   x    The abscissa
+ * @param   phi  Receives x^d, ..., x, 1
+ * @param   size The number of coefficients (degree + 1)
+ */
+template <typename T>
+void regressor(const T x, T* phi, const std::size_t size) noexcept {
+  T power_{1};
+  for (std::size_t i = size; i-- > 0;) {
+    phi[i] = power_;
+    power_ *= x;
+  }
+};
+
+/**
+ * @brief   Online polynomial fitter using recursive least squares.
+ *
+ * @tparam  T Floating-point type
+ *
+ * @details Coefficients are kept highest degree first, the layout of
+ *          config::joint_t::coeffs, so coeffs() can be passed straight to
+ *          horner::polynome. Each update() costs O(degree^2) and never
+ *          allocates; storage is sized by the constructor. A forgetting
+ *          factor below 1 lets the fit track slow drift. Not thread-safe:
+ *          copy the coefficients out with publish() to hand them over.
+ */
+template <typename T>
+class RlsFitter {
+  static_assert(std::is_floating_point_v<T>,
+                "RlsFitter: T must be a floating-point type!");
+
+ private:
+  std::size_t m_size;
+  T m_lambda;
+  std::vector<T> m_coeffs;
+  std::vector<T> m_covariance;
+  std::vector<T> m_phi;
+  std::vector<T> m_gain;
+  std::size_t m_samples{0};
+
+ public:
+  /**
+   * @brief   Constructs a fitter.
+   *
+   * @param   degree The polynomial degree
+   * @param   lambda The forgetting factor in (0, 1]
+   * @param   delta  The initial covariance scale (large for an unknown
+   *                 starting point)
+   */
+  explicit RlsFitter(std::size_t degree, T lambda = T{1}, T delta = T{1e6})
+      : m_size{degree + 1},
+        m_lambda{lambda},
+        m_coeffs(m_size),
+        m_covariance(m_size * m_size),
+        m_phi(m_size),
+        m_gain(m_size) {
+    if (!(lambda > T{0} && lambda <= T{1}))
+      throw std::invalid_argument{"RlsFitter: lambda must be in (0, 1]"};
+    reset(delta);
+  };
+
+  /**
+   * @brief   Restarts the fit from zero coefficients.
+   *
+   * @param   delta The initial covariance scale
+   */
+  void reset(T delta = T{1e6}) noexcept {
+    std::fill(m_coeffs.begin(), m_coeffs.end(), T{0});
+    std::fill(m_covariance.begin(), m_covariance.end(), T{0});
+    for (std::size_t i = 0; i < m_size; ++i)
+      m_covariance[i * m_size + i] = delta;
+    m_samples = 0;
+  };
+
+  /**
+   * @brief   Restarts the fit from known coefficients, e.g. the JSON ones or
+   *          a batch fit.
+   *
+   * @param   coeffs The coefficients (highest degree first, degree + 1)
+   * @param   delta  The initial covariance scale (small to trust them)
+   */
+  void seed(const std::vector<T>& coeffs, T delta) {
+    if (coeffs.size() != m_size)
+      throw std::invalid_argument{"RlsFitter: wrong number of coefficients"};
+    reset(delta);
+    std::copy(coeffs.begin(), coeffs.end(), m_coeffs.begin());
+  };
+
+  /**
+   * @brief   Adds one sample.
+   *
+   * @param   x The abscissa
+   * @param   y The measured value
+   * @return    The a priori prediction error
+   */
+  T update(const T x, const T y) noexcept {
+    const std::size_t n_{m_size};
+    T* phi_{m_phi.data()};
+    T* gain_{m_gain.data()};
+    T* p_{m_covariance.data()};
+    regressor(x, phi_, n_);
+
+    // gain = P phi / (lambda + phi' P phi)
+    T denom_{m_lambda}, error_{y};
+    for (std::size_t i = 0; i < n_; ++i) {
+      T sum_{0};
+      for (std::size_t j = 0; j < n_; ++j) sum_ += p_[i * n_ + j] * phi_[j];
+      gain_[i] = sum_;
+      denom_ += phi_[i] * sum_;
+      error_ -= m_coeffs[i] * phi_[i];
+    }
+
+    // P = (P - P phi phi' P / denom) / lambda, kept symmetric
+    const T invLambda_{T{1} / m_lambda}, invDenom_{T{1} / denom_};
+    for (std::size_t i = 0; i < n_; ++i) {
+      for (std::size_t j = i; j < n_; ++j) {
+        const T value_{(p_[i * n_ + j] - gain_[i] * gain_[j] * invDenom_) *
+                       invLambda_};
+        p_[i * n_ + j] = p_[j * n_ + i] = value_;
+      }
+    }
+    for (std::size_t i = 0; i < n_; ++i)
+      m_coeffs[i] += gain_[i] * invDenom_ * error_;
+    ++m_samples;
+    return error_;
+  };
+
+  /**
+   * @brief   Copies the coefficients into a caller-owned vector.
+   *
+   * @param   target The vector (no allocation if already degree + 1 long)
+   */
+  void publish(std::vector<T>& target) const {
+    target.assign(m_coeffs.begin(), m_coeffs.end());
+  };
+
+  [[nodiscard]] T predict(const T x) const noexcept {
+    return horner::polynome(m_coeffs, x);
+  };
+  [[nodiscard]] const std::vector<T>& coeffs() const noexcept {
+    return m_coeffs;
+  };
+  [[nodiscard]] std::size_t degree() const noexcept { return m_size - 1; };
+  [[nodiscard]] std::size_t samples() const noexcept { return m_samples; };
+};
+
+/**
+ * @brief   Batch polynomial least squares over large recorded datasets.
+ *
+ * @tparam  T Floating-point type
+ *
+ * @details Streams samples into the normal equations, O(degree^2) memory
+ *          regardless of the dataset size, and solves them by Cholesky
+ *          decomposition. Abscissas are scaled by their largest magnitude
+ *          internally to keep the normal equations well conditioned.
+ */
+template <typename T>
+class LeastSquares {
+  static_assert(std::is_floating_point_v<T>,
+                "LeastSquares: T must be a floating-point type!");
+
+ private:
+  std::size_t m_size;
+  T m_scale;
+  std::vector<long double> m_gram;
+  std::vector<long double> m_moment;
+  std::vector<T> m_phi;
+  std::size_t m_samples{0};
+
+ public:
+  /**
+   * @brief   Constructs an empty fit.
+   *
+   * @param   degree The polynomial degree
+   * @param   scale  The largest expected |x|, used to scale abscissas
+   */
+  explicit LeastSquares(std::size_t degree, T scale = T{1})
+      : m_size{degree + 1},
+        m_scale{scale > T{0} ? scale : T{1}},
+        m_gram(m_size * m_size),
+        m_moment(m_size),
+        m_phi(m_size) {};
+
+  /**
+   * @brief   Adds one sample.
+   *
+   * @param   x The abscissa
+   * @param   y The measured value
+   */
+  void add(const T x, const T y) noexcept {
+    regressor(x / m_scale, m_phi.data(), m_size);
+    for (std::size_t i = 0; i < m_size; ++i) {
+      for (std::size_t j = 0; j <= i; ++j)
+        m_gram[i * m_size + j] += static_cast<long double>(m_phi[i]) * m_phi[j];
+      m_moment[i] += static_cast<long double>(m_phi[i]) * y;
+    }
+    ++m_samples;
+  };
+
+  /**
+   * @brief   Adds a block of samples.
+   *
+   * @param   xs    The abscissas
+   * @param   ys    The measured values
+   * @param   count The number of samples
+   */
+  void add(const T* xs, const T* ys, const std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) add(xs[i], ys[i]);
+  };
+
+  /**
+   * @brief   Solves for the coefficients.
+   *
+   * @return  The coefficients, highest degree first
+   *
+   * @throws  std::runtime_error if the samples do not determine the fit
+   */
+  [[nodiscard]] std::vector<T> solve() const {
+    const std::size_t n_{m_size};
+    std::vector<long double> l_(m_gram);
+    for (std::size_t j = 0; j < n_; ++j) {
+      long double diag_{l_[j * n_ + j]};
+      for (std::size_t k = 0; k < j; ++k)
+        diag_ -= l_[j * n_ + k] * l_[j * n_ + k];
+      if (!(diag_ > 0))
+        throw std::runtime_error{"LeastSquares: not enough distinct samples"};
+      diag_ = std::sqrt(diag_);
+      l_[j * n_ + j] = diag_;
+      for (std::size_t i = j + 1; i < n_; ++i) {
+        long double sum_{l_[i * n_ + j]};
+        for (std::size_t k = 0; k < j; ++k)
+          sum_ -= l_[i * n_ + k] * l_[j * n_ + k];
+        l_[i * n_ + j] = sum_ / diag_;
+      }
+    }
+
+    std::vector<long double> z_(m_moment);
+    for (std::size_t i = 0; i < n_; ++i) {
+      for (std::size_t k = 0; k < i; ++k) z_[i] -= l_[i * n_ + k] * z_[k];
+      z_[i] /= l_[i * n_ + i];
+    }
+    for (std::size_t i = n_; i-- > 0;) {
+      for (std::size_t k = i + 1; k < n_; ++k) z_[i] -= l_[k * n_ + i] * z_[k];
+      z_[i] /= l_[i * n_ + i];
+    }
+
+    // Undo the scaling: c_i applies to (x / scale)^(degree - i)
+    std::vector<T> coeffs_(n_);
+    long double factor_{1};
+    for (std::size_t i = n_; i-- > 0;) {
+      coeffs_[i] = static_cast<T>(z_[i] / factor_);
+      factor_ *= m_scale;
+    }
+    return coeffs_;
+  };
+
+  void clear() noexcept {
+    std::fill(m_gram.begin(), m_gram.end(), 0.0L);
+    std::fill(m_moment.begin(), m_moment.end(), 0.0L);
+    m_samples = 0;
+  };
+  [[nodiscard]] std::size_t samples() const noexcept { return m_samples; };
+};
+
+/**
+ * @brief   Fits a polynomial to a recorded dataset in one call.
+ *
+ * @tparam  T      Floating-point type
+ * @param   xs     The abscissas
+ * @param   ys     The measured values
+ * @param   count  The number of samples
+ * @param   degree The polynomial degree
+ * @return         The coefficients, highest degree first
+ *
+ * @throws  std::runtime_error if the samples do not determine the fit
+ */
+template <typename T>
+[[nodiscard]] std::vector<T> fit(const T* xs, const T* ys,
+                                 const std::size_t count,
+                                 const std::size_t degree) {
+  T scale_{0};
+  for (std::size_t i = 0; i < count; ++i)
+    scale_ = std::max(scale_, std::abs(xs[i]));
+  LeastSquares<T> solver_{degree, scale_};
+  solver_.add(xs, ys, count);
+  return solver_.solve();
+};
+}  // namespace r2d2_fit
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_FITTING_HPP_
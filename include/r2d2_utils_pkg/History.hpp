@@ -0,0 +1,279 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_HISTORY_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_HISTORY_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "Types.hpp"
+
+namespace r2d2_history {
+enum class Interpolation : uint8_t { LINEAR, CUBIC };
+
+/**
+ * @brief   Weighted sum of one field over four samples.
+ *
+ * @tparam  T       The field type (rounded if integral)
+ * @tparam  S       The sample type
+ * @tparam  Get     Callable returning the field of a sample
+ * @param   samples The samples
+ * @param   weights The weights
+ * @param   get     The field accessor
+ * @return          The blended field
+ */
+template <typename T, typename S, typename Get>
+T blend(const S* const (&samples)[4], const double (&weights)[4], Get get) {
+  double sum_{0};
+  for (std::size_t i = 0; i < 4; ++i)
+    sum_ += weights[i] * static_cast<double>(get(*samples[i]));
+  if constexpr (std::is_integral_v<T>)
+    return static_cast<T>(std::lround(sum_));
+  else
+    return static_cast<T>(sum_);
+};
+
+/**
+ * @brief   Describes how samples of a type are interpolated.
+ *
+ * @tparam  S The sample type
+ *
+ * @details Must be specialized with a static combine() that blends four
+ *          samples with the given weights. Fields that cannot be blended are
+ *          taken from samples[1], the sample at or before the lookup time.
+ */
+template <typename S>
+struct SampleTraits;
+
+template <typename T, typename T1>
+struct SampleTraits<r2d2_type::jointbase_t<T, T1>> {
+  using S = r2d2_type::jointbase_t<T, T1>;
+
+  static S combine(const S* const (&samples)[4], const double (&weights)[4]) {
+    S result_{*samples[1]};
+    result_.omega = blend<T>(samples, weights, [](const S& s) {
+      return s.omega;
+    });
+    result_.theta = blend<T>(samples, weights, [](const S& s) {
+      return s.theta;
+    });
+    return result_;
+  };
+};
+
+template <typename T1>
+struct SampleTraits<r2d2_type::payloadbase_t<T1>> {
+  using S = r2d2_type::payloadbase_t<T1>;
+
+  static S combine(const S* const (&samples)[4], const double (&weights)[4]) {
+    S result_{*samples[1]};
+    result_.force = blend<T1>(samples, weights, [](const S& s) {
+      return s.force;
+    });
+    return result_;
+  };
+};
+
+/**
+ * @brief   Fixed-capacity ring buffer of timestamped samples.
+ *
+ * @tparam  S The sample type (jointbase_t or payloadbase_t)
+ *
+ * @details Timestamps (nanoseconds) and samples are kept in two parallel
+ *          arrays, so the binary search only touches timestamps. Storage is
+ *          allocated once by the constructor; when full, push() overwrites
+ *          the oldest sample. Timestamps must not decrease. Not thread-safe.
+ */
+template <typename S>
+class History {
+ private:
+  std::vector<int64_t> m_times{};
+  std::vector<S> m_samples{};
+  std::size_t m_mask{0};
+  std::size_t m_head{0};
+  std::size_t m_size{0};
+
+  [[nodiscard]] std::size_t slot(std::size_t index) const noexcept {
+    return (m_head + index) & m_mask;
+  };
+
+  // First logical index whose time is greater than (or not less than) t
+  template <bool Upper>
+  [[nodiscard]] std::size_t bound(int64_t timeNs) const noexcept {
+    std::size_t first_{0}, count_{m_size};
+    while (count_ > 0) {
+      const std::size_t half_{count_ / 2};
+      const int64_t time_{m_times[slot(first_ + half_)]};
+      if (Upper ? time_ <= timeNs : time_ < timeNs) {
+        first_ += half_ + 1;
+        count_ -= half_ + 1;
+      } else {
+        count_ = half_;
+      }
+    }
+    return first_;
+  };
+
+ public:
+  /**
+   * @brief   Constructs a history.
+   *
+   * @param   capacity The minimum number of samples kept (rounded up to a
+   *                   power of two)
+   */
+  explicit History(std::size_t capacity) {
+    std::size_t size_{1};
+    while (size_ < capacity) size_ <<= 1;
+    m_times.resize(size_);
+    m_samples.resize(size_);
+    m_mask = size_ - 1;
+  };
+
+  /**
+   * @brief   Appends a sample.
+   *
+   * @param   timeNs The sample time in nanoseconds
+   * @param   sample The sample
+   * @return         false if the time is older than the latest sample
+   */
+  bool push(int64_t timeNs, const S& sample) noexcept {
+    if (m_size > 0 && timeNs < time(m_size - 1)) return false;
+    if (m_size == capacity()) {
+      m_head = slot(1);
+      --m_size;
+    }
+    const std::size_t slot_{slot(m_size++)};
+    m_times[slot_] = timeNs;
+    m_samples[slot_] = sample;
+    return true;
+  };
+
+  /**
+   * @brief   Gets the sample at a time, interpolating between neighbors.
+   *
+   * @param   timeNs The lookup time in nanoseconds
+   * @param   mode   Linear, or cubic Hermite with finite-difference tangents
+   * @return         The sample, or std::nullopt outside the stored range
+   *
+   * @details O(log n). Cubic interpolation falls back to one-sided tangents
+   *          at the ends of the history.
+   */
+  [[nodiscard]] std::optional<S> at(
+      int64_t timeNs, Interpolation mode = Interpolation::LINEAR) const {
+    if (m_size == 0 || timeNs < time(0) || timeNs > time(m_size - 1))
+      return std::nullopt;
+    const std::size_t i{bound<true>(timeNs) - 1};
+    if (time(i) == timeNs) return sample(i);
+
+    const std::size_t i0_{i > 0 ? i - 1 : i};
+    const std::size_t i3_{i + 2 < m_size ? i + 2 : i + 1};
+    const S* const samples_[4]{&sample(i0_), &sample(i), &sample(i + 1),
+                               &sample(i3_)};
+    const auto t_{[this](std::size_t index) {
+      return static_cast<double>(time(index));
+    }};
+    const double t0_{t_(i0_)}, t1_{t_(i)}, t2_{t_(i + 1)}, t3_{t_(i3_)};
+    const double dt_{t2_ - t1_}, s_{(static_cast<double>(timeNs) - t1_) / dt_};
+    if (mode == Interpolation::LINEAR)
+      return SampleTraits<S>::combine(samples_, {0, 1 - s_, s_, 0});
+
+    const double s2_{s_ * s_}, s3_{s2_ * s_};
+    const double h00_{2 * s3_ - 3 * s2_ + 1}, h01_{3 * s2_ - 2 * s3_};
+    const double a_{(s3_ - 2 * s2_ + s_) * dt_ / (t2_ - t0_)};
+    const double b_{(s3_ - s2_) * dt_ / (t3_ - t1_)};
+    return SampleTraits<S>::combine(samples_,
+                                    {-a_, h00_ - b_, h01_ + a_, b_});
+  };
+
+  /**
+   * @brief   Calls a function for each sample in a time window, oldest
+   *          first.
+   *
+   * @tparam  F      Callable taking (int64_t timeNs, const S& sample)
+   * @param   fromNs Start of the window (inclusive)
+   * @param   toNs   End of the window (inclusive)
+   * @param   fn     The function
+   * @return         The number of samples visited
+   */
+  template <typename F>
+  std::size_t for_each_in(int64_t fromNs, int64_t toNs, F&& fn) const {
+    std::size_t count_{0};
+    for (std::size_t i = bound<false>(fromNs); i < m_size && time(i) <= toNs;
+         ++i, ++count_)
+      fn(time(i), sample(i));
+    return count_;
+  };
+
+  /**
+   * @brief   Gets a sample by age order.
+   *
+   * @param   index 0 for the oldest sample, size() - 1 for the latest
+   * @return        Reference to the sample
+   */
+  [[nodiscard]] const S& sample(std::size_t index) const noexcept {
+    return m_samples[slot(index)];
+  };
+  [[nodiscard]] int64_t time(std::size_t index) const noexcept {
+    return m_times[slot(index)];
+  };
+
+  void clear() noexcept { m_head = m_size = 0; };
+  [[nodiscard]] bool empty() const noexcept { return m_size == 0; };
+  [[nodiscard]] std::size_t size() const noexcept { return m_size; };
+  [[nodiscard]] std::size_t capacity() const noexcept { return m_mask + 1; };
+};
+
+/**
+ * @brief   Copies the joint samples of a time window into SoA arrays.
+ *
+ * @param   history  The history
+ * @param   fromNs   Start of the window (inclusive)
+ * @param   toNs     End of the window (inclusive)
+ * @param   times    Receives the sample times
+ * @param   omegas   Receives the angular velocities
+ * @param   thetas   Receives the angles
+ * @param   capacity The length of each output array
+ * @return           The number of samples written (at most capacity)
+ */
+template <typename T, typename T1>
+std::size_t extract(const History<r2d2_type::jointbase_t<T, T1>>& history,
+                    int64_t fromNs, int64_t toNs, int64_t* times, T* omegas,
+                    T* thetas, std::size_t capacity) {
+  std::size_t count_{0};
+  history.for_each_in(fromNs, toNs, [&](int64_t timeNs, const auto& sample) {
+    if (count_ == capacity) return;
+    times[count_] = timeNs;
+    omegas[count_] = sample.omega;
+    thetas[count_++] = sample.theta;
+  });
+  return count_;
+};
+
+/**
+ * @brief   Copies the payload samples of a time window into SoA arrays.
+ *
+ * @param   history  The history
+ * @param   fromNs   Start of the window (inclusive)
+ * @param   toNs     End of the window (inclusive)
+ * @param   times    Receives the sample times
+ * @param   forces   Receives the forces
+ * @param   capacity The length of each output array
+ * @return           The number of samples written (at most capacity)
+ */
+template <typename T1>
+std::size_t extract(const History<r2d2_type::payloadbase_t<T1>>& history,
+                    int64_t fromNs, int64_t toNs, int64_t* times, T1* forces,
+                    std::size_t capacity) {
+  std::size_t count_{0};
+  history.for_each_in(fromNs, toNs, [&](int64_t timeNs, const auto& sample) {
+    if (count_ == capacity) return;
+    times[count_] = timeNs;
+    forces[count_++] = sample.force;
+  });
+  return count_;
+};
+}  // namespace r2d2_history
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_HISTORY_HPP_
@@ -1,12 +1,20 @@
 #ifndef INCLUDE_R2D2_UTILS_PKG_JSON_HPP_
 #define INCLUDE_R2D2_UTILS_PKG_JSON_HPP_
 
+#include <cstddef>
 #include <fstream>
 #include <nlohmann/json.hpp>
+#include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 
+#include "Errors/Result.hpp"
 #include "Exceptions.hpp"
+#include "Symbols.hpp"
+#include "Types.hpp"
 
 namespace r2d2_json {
 /**
@@ -16,6 +24,112 @@ namespace r2d2_json {
  * @return           The full path to the configuration file
  */
 std::string getFilePath(std::string_view fileName) noexcept;
+
+namespace detail {
+template <typename T, typename = void>
+struct is_range : std::false_type {};
+template <typename T>
+struct is_range<T, std::void_t<typename T::value_type,
+                               decltype(std::declval<const T&>().begin())>>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct is_mapping : std::false_type {};
+template <typename T>
+struct is_mapping<T, std::void_t<typename T::key_type, typename T::mapped_type>>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct is_tuple_like : std::false_type {};
+template <typename T>
+struct is_tuple_like<T, std::void_t<decltype(std::tuple_size<T>::value)>>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct has_fields : std::false_type {};
+template <typename T>
+struct has_fields<
+    T, std::void_t<decltype(r2d2_type::config::FieldTraits<T>::fields)>>
+    : std::true_type {};
+
+template <typename T, std::size_t... I>
+bool holds_elements(const nlohmann::json& json,
+                    std::index_sequence<I...>) noexcept;
+}  // namespace detail
+
+/**
+ * @brief   Checks whether a JSON value converts to T without throwing.
+ *
+ * @tparam  T    The target type
+ * @param   json The JSON value
+ * @return       False if the conversion to T would fail
+ *
+ * @details Booleans, numbers and strings must match exactly; enumerations
+ *          accept numbers and strings. Containers are checked element by
+ *          element: maps with string keys need an object, other maps an
+ *          array of pairs, ranges an array, and tuples and std::array an
+ *          array of at least their size. Configuration structures with
+ *          r2d2_type::config::FieldTraits need an object holding every
+ *          field. Other types cannot be checked and are rejected at compile
+ *          time.
+ */
+template <typename T>
+[[nodiscard]] bool holds(const nlohmann::json& json) noexcept {
+  if constexpr (std::is_same_v<T, nlohmann::json>) {
+    return true;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return json.is_boolean();
+  } else if constexpr (std::is_arithmetic_v<T>) {
+    return json.is_number();
+  } else if constexpr (std::is_enum_v<T>) {
+    return json.is_number() || json.is_string();
+  } else if constexpr (std::is_constructible_v<T, std::string>) {
+    return json.is_string();
+  } else if constexpr (detail::is_mapping<T>::value) {
+    using Key = typename T::key_type;
+    using Mapped = typename T::mapped_type;
+    if constexpr (std::is_constructible_v<Key, std::string>) {
+      if (!json.is_object()) return false;
+      for (const auto& value_ : json)
+        if (!holds<Mapped>(value_)) return false;
+      return true;
+    } else {
+      if (!json.is_array()) return false;
+      for (const auto& pair_ : json)
+        if (!holds<std::pair<Key, Mapped>>(pair_)) return false;
+      return true;
+    }
+  } else if constexpr (detail::is_tuple_like<T>::value) {
+    constexpr std::size_t size_{std::tuple_size<T>::value};
+    if (!json.is_array() || json.size() < size_) return false;
+    return detail::holds_elements<T>(json, std::make_index_sequence<size_>{});
+  } else if constexpr (detail::is_range<T>::value) {
+    if (!json.is_array()) return false;
+    for (const auto& value_ : json)
+      if (!holds<typename T::value_type>(value_)) return false;
+    return true;
+  } else if constexpr (detail::has_fields<T>::value) {
+    if (!json.is_object()) return false;
+    return std::apply(
+        [&json](const auto&... field) {
+          return ((json.contains(field.first) &&
+                   holds<std::decay_t<decltype(T{}.*field.second)>>(
+                       json[field.first])) &&
+                  ...);
+        },
+        r2d2_type::config::FieldTraits<T>::fields);
+  } else {
+    static_assert(std::is_same_v<T, bool>,
+                  "holds: the conversion to T cannot be checked");
+    return false;
+  }
+};
+
+template <typename T, std::size_t... I>
+bool detail::holds_elements(const nlohmann::json& json,
+                            std::index_sequence<I...>) noexcept {
+  return (holds<std::tuple_element_t<I, T>>(json[I]) && ...);
+};
 }  // namespace r2d2_json
 
 /**
@@ -60,6 +174,30 @@ class IJsonConfig {
     if (!m_json.contains(key)) throw r2d2_errors::json::ParameterError{key};
     return m_json.at(std::string(key)).template get<T>();
   }
+
+  /**
+   * @brief   Gets a parameter value from the JSON configuration without
+   *          throwing.
+   *
+   * @tparam  T   The type to retrieve the parameter as (default: double)
+   * @param   key The parameter key
+   * @return      Result holding the parameter value, or
+   *              r2d2_errors::ErrorCode::PARAMETER if the key is not found, or
+   *              r2d2_errors::ErrorCode::TYPE if the value has a wrong type
+   *
+   * @details The value is checked up front, down to the element types (see
+   *          r2d2_json::holds()), so the conversion itself cannot throw.
+   */
+  template <typename T = double>
+  [[nodiscard]] r2d2_errors::Result<T> try_getParam(
+      std::string_view key) const {
+    const auto it_{m_json.find(key)};
+    if (it_ == m_json.end())
+      return r2d2_errors::fail(r2d2_errors::ErrorCode::PARAMETER);
+    if (!r2d2_json::holds<T>(*it_))
+      return r2d2_errors::fail(r2d2_errors::ErrorCode::TYPE);
+    return it_->template get<T>();
+  }
 };
 
 /**
@@ -68,16 +206,23 @@ class IJsonConfig {
  *
  * @param   fileName The name of the JSON configuration file
  *
- * @details Errors are recorded in the error queue instead of being thrown.
+ * @details Errors are recorded in the error record instead of being thrown.
+ *          A file that cannot be parsed leaves the configuration empty.
  */
 template <>
 inline IJsonConfig<true>::IJsonConfig(std::string_view fileName) {
-  try {
-    std::ifstream file{r2d2_json::getFilePath(fileName)};
-    if (!file) throw r2d2_errors::json::FileNotFoundError{fileName};
-    file >> m_json;
-  } catch (const std::exception& e) {
-    RECORD_ERROR(e);
+  using r2d2_errors::ErrorCode;
+  using r2d2_errors::ErrorInfo;
+
+  std::ifstream file{r2d2_json::getFilePath(fileName)};
+  if (!file) {
+    RECORD_ERROR((ErrorInfo{ErrorCode::FILE_NOT_FOUND, fileName}));
+    return;
+  }
+  m_json = nlohmann::json::parse(file, nullptr, false);
+  if (m_json.is_discarded()) {
+    m_json = nlohmann::json{};
+    RECORD_ERROR((ErrorInfo{ErrorCode::FILE_PARSE, fileName}));
   }
 };
 
@@ -88,21 +233,19 @@ inline IJsonConfig<true>::IJsonConfig(std::string_view fileName) {
  * @tparam  T   The type to retrieve the parameter as
  * @param   key The parameter key
  * @return      The parameter value, or default-constructed T if key is not
- *              found
+ *              found or has a wrong type
  *
- * @details Errors are recorded in the error queue instead of being thrown.
+ * @details Built on try_getParam(): errors are recorded in the error record
+ *          as structured errors, without throwing.
  */
 template <>
 template <typename T>
 [[nodiscard]]
 inline T IJsonConfig<true>::getParam(std::string_view key) const {
-  try {
-    if (!m_json.contains(key)) throw r2d2_errors::json::ParameterError{key};
-    return m_json.at(std::string(key)).template get<T>();
-  } catch (const std::exception& e) {
-    RECORD_ERROR(e);
-    return T{};
-  }
+  auto result_{try_getParam<T>(key)};
+  if (result_) return *std::move(result_);
+  RECORD_ERROR((r2d2_errors::ErrorInfo{result_.error(), key}));
+  return T{};
 };
 
 /**
@@ -112,12 +255,22 @@ inline T IJsonConfig<true>::getParam(std::string_view key) const {
  * @tparam  T    Numeric type for the configuration values (default: double)
  *
  * @details Loads JSON and deserializes entries into a map of configuration
- *          objects.
+ *          objects. The map is keyed on folded symbols (fill it with
+ *          insert()), so keys are matched ignoring ASCII case and do not
+ *          depend on the lifetime of the JSON document. String keys are
+ *          looked up in a second, case-insensitive map of the interned
+ *          text, so only insert() touches the symbol pool.
+ *          When the file is fixed at build time, r2d2_static::ConfigMap
+ *          offers the same access without parsing (see StaticConfig.hpp).
  */
 template <template <typename> class Type, typename T = double>
 class IJsonConfigMap : public IJsonConfig<> {
  private:
-  std::unordered_map<std::string_view, Type<T>> m_paramsMap;
+  std::unordered_map<r2d2_symbol::FoldedSymbol, Type<T>> m_paramsMap;
+  std::unordered_map<std::string_view, r2d2_symbol::FoldedSymbol,
+                     r2d2_string::CaseInsensitiveHash,
+                     r2d2_string::CaseInsensitiveEqual>
+      m_keyMap;
 
  public:
   /**
@@ -127,6 +280,21 @@ class IJsonConfigMap : public IJsonConfig<> {
    */
   IJsonConfigMap(std::string_view fileName);
 
+ protected:
+  /**
+   * @brief   Adds a configuration object under a key.
+   *
+   * @param   key    The configuration key
+   * @param   params The configuration object
+   * @return         False if a key equal ignoring ASCII case already exists
+   */
+  bool insert(std::string_view key, Type<T> params) {
+    const r2d2_symbol::FoldedSymbol symbol_{r2d2_symbol::intern_folded(key)};
+    if (!m_paramsMap.emplace(symbol_, std::move(params)).second) return false;
+    m_keyMap.emplace(symbol_.str(), symbol_);
+    return true;
+  };
+
  public:
   /**
    * @brief   Gets a configuration object by key.
@@ -137,9 +305,39 @@ class IJsonConfigMap : public IJsonConfig<> {
    * @throws  r2d2_errors::json::ObjectParseError if the key is not found
    */
   [[nodiscard]] Type<T> getParams(std::string_view key) const {
+    if (auto result_ = try_getParams(key)) return *std::move(result_);
+    throw r2d2_errors::json::ObjectParseError{key};
+  };
+
+  /**
+   * @brief   Gets a configuration object by key without throwing.
+   *
+   * @param   key The configuration key
+   * @return      Result holding the configuration object, or
+   *              r2d2_errors::ErrorCode::OBJECT_PARSE if the key is not found
+   *
+   * @details Hashes the key ignoring ASCII case; does not lock the symbol
+   *          pool.
+   */
+  [[nodiscard]] r2d2_errors::Result<Type<T>> try_getParams(
+      std::string_view key) const {
+    if (auto it = m_keyMap.find(key); it != m_keyMap.end())
+      return try_getParams(it->second);
+    return r2d2_errors::fail(r2d2_errors::ErrorCode::OBJECT_PARSE);
+  };
+
+  /**
+   * @brief   Gets a configuration object by key symbol without throwing.
+   *
+   * @param   key The folded symbol of the key (see find_folded())
+   * @return      Result holding the configuration object, or
+   *              r2d2_errors::ErrorCode::OBJECT_PARSE if the key is not found
+   */
+  [[nodiscard]] r2d2_errors::Result<Type<T>> try_getParams(
+      r2d2_symbol::FoldedSymbol key) const {
     if (auto it = m_paramsMap.find(key); it != m_paramsMap.end())
       return it->second;
-    throw r2d2_errors::json::ObjectParseError{key};
+    return r2d2_errors::fail(r2d2_errors::ErrorCode::OBJECT_PARSE);
   };
 };
 #endif  // INCLUDE_R2D2_UTILS_PKG_JSON_HPP_
@@ -0,0 +1,606 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_ASYNC_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_ASYNC_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Console.hpp"
+#include "Debug.hpp"
+
+/**
+ * @brief   Logs the arguments of a debug macro through the asynchronous
+ *          backend.
+ *
+ * @details The call site is described by a function-local static CallSite;
+ *          at runtime only the raw argument bytes are copied into the calling
+ *          thread's ring. Formatting happens on the logger thread. names is
+ *          the argument list stringified by the user-facing macro.
+ */
+#define DEBUG_ASYNC_LOG(kind, label, names, ...)                        \
+  do {                                                                  \
+    static const r2d2_async::CallSite site_{                            \
+        kind, __func__, ANSI_WHITE, VarNames{std::string_view{names}}}; \
+    r2d2_async::log(site_, label, __VA_ARGS__);                         \
+  } while (false)
+
+#define ROS_DEBUG_ASYNC_VARS(...)                                 \
+  DEBUG_ASYNC_LOG(r2d2_async::SiteKind::VARS, std::string_view{}, \
+                  #__VA_ARGS__, __VA_ARGS__)
+#define ROS_DEBUG_ASYNC_VOID(...)                                 \
+  DEBUG_ASYNC_LOG(r2d2_async::SiteKind::VOID, std::string_view{}, \
+                  #__VA_ARGS__, __VA_ARGS__)
+#define ROS_DEBUG_ASYNC_FUNC(output, ...)                         \
+  DEBUG_ASYNC_LOG(r2d2_async::SiteKind::FUNC, std::string_view{}, \
+                  #output ", " #__VA_ARGS__, output, __VA_ARGS__)
+
+#define ROS_DEBUG_ASYNC_NAMED_VARS(name, ...)                     \
+  DEBUG_ASYNC_LOG(r2d2_async::SiteKind::VARS, name, #__VA_ARGS__, \
+                  __VA_ARGS__)
+#define ROS_DEBUG_ASYNC_NAMED_VOID(name, ...)                     \
+  DEBUG_ASYNC_LOG(r2d2_async::SiteKind::VOID, name, #__VA_ARGS__, \
+                  __VA_ARGS__)
+#define ROS_DEBUG_ASYNC_NAMED_FUNC(name, output, ...) \
+  DEBUG_ASYNC_LOG(r2d2_async::SiteKind::FUNC, name,   \
+                  #output ", " #__VA_ARGS__, output, __VA_ARGS__)
+
+namespace r2d2_async {
+constexpr std::size_t ASYNC_RING_CAPACITY{1024};
+constexpr std::size_t ASYNC_RECORD_LEN{128};
+constexpr std::size_t ASYNC_LABEL_LEN{32};
+
+enum class SiteKind : std::uint8_t { VARS = 0, VOID, FUNC };
+enum class OverflowPolicy : std::uint8_t { DROP = 0, BLOCK };
+
+/**
+ * @brief   Static description of a logging call site.
+ */
+struct CallSite {
+  SiteKind kind;
+  const char* func;
+  const char* color;
+  VarNames names;
+};
+
+/**
+ * @brief   Portable code of a loggable argument type.
+ */
+enum class TypeCode : std::uint8_t {
+  NONE = 0,
+  BOOL,
+  CHAR,
+  I8,
+  U8,
+  I16,
+  U16,
+  I32,
+  U32,
+  I64,
+  U64,
+  F32,
+  F64,
+  F80
+};
+
+/**
+ * @brief   Gets the type code of a loggable type.
+ *
+ * @tparam  T The argument type (enums use their underlying type)
+ * @return    The type code, TypeCode::NONE for unsupported types
+ */
+template <typename T>
+constexpr TypeCode type_code() {
+  if constexpr (std::is_enum_v<T>)
+    return type_code<std::underlying_type_t<T>>();
+  else if constexpr (std::is_same_v<T, bool>)
+    return TypeCode::BOOL;
+  else if constexpr (std::is_same_v<T, char>)
+    return TypeCode::CHAR;
+  else if constexpr (std::is_integral_v<T>) {
+    constexpr bool signed_{std::is_signed_v<T>};
+    switch (sizeof(T)) {
+      case 1: return signed_ ? TypeCode::I8 : TypeCode::U8;
+      case 2: return signed_ ? TypeCode::I16 : TypeCode::U16;
+      case 4: return signed_ ? TypeCode::I32 : TypeCode::U32;
+      case 8: return signed_ ? TypeCode::I64 : TypeCode::U64;
+      default: return TypeCode::NONE;
+    }
+  } else if constexpr (std::is_same_v<T, float>)
+    return TypeCode::F32;
+  else if constexpr (std::is_same_v<T, double>)
+    return TypeCode::F64;
+  else if constexpr (std::is_same_v<T, long double>)
+    return TypeCode::F80;
+  else
+    return TypeCode::NONE;
+};
+
+struct Record;
+using Decoder = void (*)(std::ostream&, const Record&);
+
+/**
+ * @brief   Static description of the argument types of a record.
+ *
+ * @details One instance exists per distinct argument type list, so the
+ *          types can be recovered from a record without knowing them at
+ *          compile time (e.g. by a binary sink).
+ */
+struct RecordFormat {
+  Decoder decode;
+  std::uint8_t count;
+  std::uint16_t argsLen;
+  std::array<TypeCode, ASYNC_RECORD_LEN> types;
+};
+
+/**
+ * @brief   Fixed-size raw log record.
+ *
+ * @details The payload holds the label bytes followed by the raw bytes of
+ *          every argument; the format knows their types.
+ */
+struct alignas(64) Record {
+  const RecordFormat* format;
+  const CallSite* site;
+  std::int64_t timeNs;
+  std::uint8_t labelLen;
+  std::array<std::byte, ASYNC_RECORD_LEN - 32> payload;
+};
+static_assert(sizeof(Record) == ASYNC_RECORD_LEN,
+              "Record must fill exactly ASYNC_RECORD_LEN bytes!");
+
+constexpr std::size_t ASYNC_ARGS_LEN{sizeof(Record::payload) -
+                                     ASYNC_LABEL_LEN};
+
+/**
+ * @brief   Checks whether a type can be logged as raw bytes.
+ *
+ * @tparam  T The argument type
+ */
+template <typename T>
+constexpr bool is_loggable_v = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+/**
+ * @brief   Single-producer single-consumer ring of records owned by one
+ *          thread.
+ */
+class ThreadRing {
+ private:
+  std::uint32_t m_id;
+  std::array<Record, ASYNC_RING_CAPACITY> m_records{};
+  alignas(64) std::atomic<std::size_t> m_head{0};
+  alignas(64) std::atomic<std::size_t> m_tail{0};
+  alignas(64) std::atomic<std::uint64_t> m_dropped{0};
+  std::atomic<bool> m_retired{false};
+
+ public:
+  /**
+   * @brief   Constructs a ThreadRing.
+   *
+   * @param   id The producer thread number, in registration order
+   */
+  explicit ThreadRing(std::uint32_t id) noexcept : m_id{id} {};
+
+  [[nodiscard]] std::uint32_t id() const noexcept { return m_id; };
+
+  /**
+   * @brief   Fills the next free record in place.
+   *
+   * @tparam  Fill   Callable taking a Record&
+   * @param   fill   The callback writing the record
+   * @param   policy What to do when the ring is full
+   * @param   alive  Flag that stops blocking once cleared
+   * @return         True if the record was written
+   */
+  template <typename Fill>
+  bool push(Fill&& fill, OverflowPolicy policy,
+            const std::atomic<bool>& alive) noexcept {
+    const std::size_t head_{m_head.load(std::memory_order_relaxed)};
+    while (head_ - m_tail.load(std::memory_order_acquire) >=
+           ASYNC_RING_CAPACITY) {
+      if (policy == OverflowPolicy::DROP ||
+          !alive.load(std::memory_order_relaxed)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      std::this_thread::yield();
+    }
+    fill(m_records[head_ & (ASYNC_RING_CAPACITY - 1)]);
+    m_head.store(head_ + 1, std::memory_order_release);
+    return true;
+  };
+
+  /**
+   * @brief   Consumes every published record.
+   *
+   * @tparam  Func Callable taking a const Record&
+   * @param   func The callback invoked for each record
+   * @return       The number of consumed records
+   */
+  template <typename Func>
+  std::size_t drain(Func&& func) {
+    const std::size_t head_{m_head.load(std::memory_order_acquire)};
+    std::size_t tail_{m_tail.load(std::memory_order_relaxed)};
+    const std::size_t count_{head_ - tail_};
+    for (; tail_ != head_; ++tail_)
+      func(m_records[tail_ & (ASYNC_RING_CAPACITY - 1)]);
+    m_tail.store(tail_, std::memory_order_release);
+    return count_;
+  };
+
+  [[nodiscard]] bool empty() const noexcept {
+    return m_head.load(std::memory_order_acquire) ==
+           m_tail.load(std::memory_order_relaxed);
+  };
+  std::uint64_t take_dropped() noexcept {
+    return m_dropped.exchange(0, std::memory_order_relaxed);
+  };
+  void retire() noexcept { m_retired.store(true, std::memory_order_release); };
+  [[nodiscard]] bool retired() const noexcept {
+    return m_retired.load(std::memory_order_acquire);
+  };
+};
+
+using Sink = void (*)(std::string_view line);
+
+/**
+ * @brief   Writes a formatted line to stderr.
+ *
+ * @param   line The formatted line
+ */
+inline void stderr_sink(std::string_view line) {
+  std::fwrite(line.data(), 1, line.size(), stderr);
+  std::fputc('\n', stderr);
+};
+
+/**
+ * @brief   Interface of a consumer of raw records.
+ *
+ * @details Every method is called on the logger thread only.
+ */
+class IRecordSink {
+ public:
+  virtual ~IRecordSink() = default;
+
+  /**
+   * @brief   Consumes a record.
+   *
+   * @param   record The raw record
+   * @param   thread The producer thread number
+   */
+  virtual void write(const Record& record, std::uint32_t thread) = 0;
+
+  /**
+   * @brief   Reports records dropped by a producer on overflow.
+   *
+   * @param   count  The number of dropped records
+   * @param   thread The producer thread number
+   */
+  virtual void dropped(std::uint64_t count, std::uint32_t thread) = 0;
+
+  /**
+   * @brief   Makes every consumed record durable or visible.
+   */
+  virtual void flush() {};
+};
+
+/**
+ * @brief   Record sink that formats records to text lines.
+ */
+class TextSink final : public IRecordSink {
+ private:
+  Sink m_sink;
+  std::ostringstream m_oss{};
+
+ public:
+  explicit TextSink(Sink sink = stderr_sink) noexcept : m_sink{sink} {};
+
+  void write(const Record& record, std::uint32_t /*thread*/) override {
+    m_oss.str({});
+    record.format->decode(m_oss, record);
+    m_sink(m_oss.str());
+  };
+
+  void dropped(std::uint64_t count, std::uint32_t /*thread*/) override {
+    m_oss.str({});
+    m_oss << ANSI_RED << "Dropped " << count << " debug record(s)!"
+          << ANSI_RESET;
+    m_sink(m_oss.str());
+  };
+};
+
+/**
+ * @brief   Background logger that formats raw records from every thread ring.
+ *
+ * @details Each producing thread registers its own ring on its first log
+ *          call (the only allocation on the producer side). The logger
+ *          thread polls all rings, formats records with their decoders and
+ *          passes the lines to the sink. Records dropped on overflow are
+ *          counted per thread and reported as a line of their own. Rings of
+ *          exited threads are released once drained.
+ */
+class Logger {
+ private:
+  std::mutex m_mutex{};
+  std::vector<std::shared_ptr<ThreadRing>> m_rings{};
+  std::thread m_thread{};
+  std::atomic<bool> m_running{false};
+  std::atomic<OverflowPolicy> m_policy{OverflowPolicy::DROP};
+  std::chrono::nanoseconds m_interval{std::chrono::milliseconds{1}};
+  TextSink m_textSink{};
+  IRecordSink* m_sink{&m_textSink};
+  std::uint32_t m_ringCount{0};
+
+  struct RingHandle {
+    std::shared_ptr<ThreadRing> ring{};
+    ~RingHandle() {
+      if (ring) ring->retire();
+    };
+  };
+
+ public:
+  Logger() = default;
+  Logger(const Logger&) = delete;
+  Logger& operator=(const Logger&) = delete;
+  ~Logger() { stop(); };
+
+  /**
+   * @brief   Starts the logger thread.
+   *
+   * @param   sink     The line sink called on the logger thread
+   * @param   policy   What producers do when their ring is full
+   * @param   interval Polling interval when all rings are empty
+   */
+  void start(Sink sink = stderr_sink,
+             OverflowPolicy policy = OverflowPolicy::DROP,
+             std::chrono::nanoseconds interval = std::chrono::milliseconds{1}) {
+    if (m_thread.joinable()) return;
+    m_textSink = TextSink{sink};
+    start(m_textSink, policy, interval);
+  };
+
+  /**
+   * @brief   Starts the logger thread with a record sink.
+   *
+   * @param   sink     The record sink, which must outlive the logger thread
+   * @param   policy   What producers do when their ring is full
+   * @param   interval Polling interval when all rings are empty
+   */
+  void start(IRecordSink& sink, OverflowPolicy policy = OverflowPolicy::DROP,
+             std::chrono::nanoseconds interval = std::chrono::milliseconds{1}) {
+    if (m_thread.joinable()) return;
+    m_sink = &sink;
+    m_policy.store(policy, std::memory_order_relaxed);
+    m_interval = interval;
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread{&Logger::run, this};
+  };
+
+  /**
+   * @brief   Stops the logger thread after draining every ring.
+   */
+  void stop() noexcept {
+    if (!m_thread.joinable()) return;
+    m_running.store(false, std::memory_order_release);
+    m_thread.join();
+    drain_all();
+    m_sink->flush();
+  };
+
+  [[nodiscard]] bool running() const noexcept {
+    return m_running.load(std::memory_order_relaxed);
+  };
+
+  /**
+   * @brief   Writes a record into the calling thread's ring.
+   *
+   * @tparam  Fill Callable taking a Record&
+   * @param   fill The callback writing the record
+   * @return       True if the record was written
+   */
+  template <typename Fill>
+  bool push(Fill&& fill) noexcept {
+    ThreadRing* ring_{thread_ring()};
+    if (!ring_) return false;
+    return ring_->push(std::forward<Fill>(fill),
+                       m_policy.load(std::memory_order_relaxed), m_running);
+  };
+
+ private:
+  ThreadRing* thread_ring() noexcept {
+    thread_local RingHandle handle_{};
+    if (!handle_.ring) {
+      try {
+        std::lock_guard lock_{m_mutex};
+        handle_.ring = std::make_shared<ThreadRing>(m_ringCount++);
+        m_rings.push_back(handle_.ring);
+      } catch (...) {
+        handle_.ring.reset();
+      }
+    }
+    return handle_.ring.get();
+  };
+
+  std::size_t drain_all() {
+    std::lock_guard lock_{m_mutex};
+    std::size_t count_{0};
+    for (auto& ring_ : m_rings) {
+      count_ += ring_->drain(
+          [&](const Record& record) { m_sink->write(record, ring_->id()); });
+      if (const auto dropped_{ring_->take_dropped()}; dropped_ > 0)
+        m_sink->dropped(dropped_, ring_->id());
+    }
+    m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+                                 [](const auto& ring) {
+                                   return ring->retired() && ring->empty();
+                                 }),
+                  m_rings.end());
+    return count_;
+  };
+
+  void run() {
+    while (m_running.load(std::memory_order_acquire))
+      if (drain_all() == 0) std::this_thread::sleep_for(m_interval);
+  };
+};
+
+/**
+ * @brief   Gets the process-wide asynchronous logger.
+ *
+ * @return  Reference to the logger
+ */
+inline Logger& logger() noexcept {
+  static Logger logger_{};
+  return logger_;
+};
+
+/**
+ * @brief   Streams the text of a SiteKind::FUNC call site.
+ *
+ * @tparam  Output The result type
+ * @tparam  Args   Value types
+ * @param   os     The output stream
+ * @param   site   The call site
+ * @param   output The decoded result
+ * @param   args   The decoded values
+ */
+template <typename Output, typename... Args>
+void write_result(std::ostream& os, const CallSite& site, const Output& output,
+                  const Args&... args) {
+  os << site.func << '('
+     << stream_args(site.color, site.names.tail(), args...) << ") : "
+     << r2d2_format::paint(ANSI_WHITE, output).view();
+};
+
+/**
+ * @brief   Streams a call site's text for already decoded values.
+ *
+ * @tparam  Args Value types
+ * @param   os   The output stream
+ * @param   site The call site
+ * @param   args The decoded values (the result first for SiteKind::FUNC)
+ */
+template <typename... Args>
+void write_site(std::ostream& os, const CallSite& site, const Args&... args) {
+  switch (site.kind) {
+    case SiteKind::VARS:
+      os << stream_args(site.color, site.names, args...);
+      break;
+    case SiteKind::VOID:
+      os << site.func << '(' << stream_args(site.color, site.names, args...)
+         << ')';
+      break;
+    case SiteKind::FUNC:
+      if constexpr (sizeof...(Args) > 1) write_result(os, site, args...);
+      break;
+  }
+};
+
+/**
+ * @brief   Converts an enum to its underlying type for streaming.
+ *
+ * @tparam  T     The value type
+ * @param   value The decoded value
+ * @return        The underlying value for enums, the value otherwise
+ */
+template <typename T>
+constexpr auto printable(const T& value) {
+  if constexpr (std::is_enum_v<T>)
+    return static_cast<std::underlying_type_t<T>>(value);
+  else
+    return value;
+};
+
+/**
+ * @brief   Decodes a record whose payload holds values of the given types.
+ *
+ * @tparam  Args The argument types, in payload order
+ * @param   os     The output stream
+ * @param   record The raw record
+ */
+template <typename... Args>
+void decode(std::ostream& os, const Record& record) {
+  std::tuple<Args...> args_{};
+  std::size_t pos_{record.labelLen};
+  std::apply(
+      [&](auto&... values) {
+        ((std::memcpy(&values, record.payload.data() + pos_, sizeof(values)),
+          pos_ += sizeof(values)),
+         ...);
+      },
+      args_);
+  if (record.labelLen > 0)
+    os << '[' << std::string_view{reinterpret_cast<const char*>(
+                                      record.payload.data()),
+                                  record.labelLen}
+       << "] ";
+  std::apply(
+      [&](const auto&... values) {
+        write_site(os, *record.site, printable(values)...);
+      },
+      args_);
+};
+
+/**
+ * @brief   Format of records holding values of the given types.
+ *
+ * @tparam  Args The argument types, in payload order
+ */
+template <typename... Args>
+inline constexpr RecordFormat RECORD_FORMAT{
+    &decode<Args...>,
+    static_cast<std::uint8_t>(sizeof...(Args)),
+    static_cast<std::uint16_t>((sizeof(Args) + ... + 0)),
+    {type_code<Args>()...}};
+
+/**
+ * @brief   Logs raw argument bytes for a call site.
+ *
+ * @tparam  Args Argument types (arithmetic or enum)
+ * @param   site  The static call site
+ * @param   label Optional label, truncated to ASYNC_LABEL_LEN characters
+ * @param   args  The values to log
+ *
+ * @details Does nothing while the logger is not running. Otherwise copies the
+ *          decoder, call site, timestamp, label and argument bytes into the
+ *          calling thread's ring without locking or allocating.
+ */
+template <typename... Args>
+void log(const CallSite& site, std::string_view label,
+         const Args&... args) noexcept {
+  static_assert((is_loggable_v<Args> && ...),
+                "Asynchronous debug arguments must be arithmetic or enum!");
+  static_assert((sizeof(Args) + ... + 0) <= ASYNC_ARGS_LEN,
+                "Too many asynchronous debug arguments!");
+  Logger& logger_{logger()};
+  if (!logger_.running()) return;
+  logger_.push([&](Record& record) {
+    record.format = &RECORD_FORMAT<Args...>;
+    record.site = &site;
+    record.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count();
+    record.labelLen = static_cast<std::uint8_t>(label.copy(
+        reinterpret_cast<char*>(record.payload.data()), ASYNC_LABEL_LEN));
+    std::size_t pos_{record.labelLen};
+    ((std::memcpy(record.payload.data() + pos_, &args, sizeof(Args)),
+      pos_ += sizeof(Args)),
+     ...);
+  });
+};
+}  // namespace r2d2_async
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_ASYNC_HPP_
@@ -3,97 +3,318 @@
 
 #include <ros/console.h>
 
+#include "Async.hpp"   // IWYU pragma: export
 #include "Color.hpp"   // IWYU pragma: keep
 #include "Debug.hpp"   // IWYU pragma: export
 #include "DebugC.hpp"  // IWYU pragma: export
+#include "Format.hpp"  // IWYU pragma: export
+#include "Gate.hpp"    // IWYU pragma: export
+#include "Scope.hpp"   // IWYU pragma: export
 
+/**
+ * @brief   Formats a colored value.
+ *
+ * @tparam  T     The value type
+ * @param   color ANSI color code
+ * @param   value The value
+ * @return        The colored text
+ *
+ * @details Copies the result out of the thread-local VALUE buffer; the debug
+ *          macros use r2d2_format::paint() directly, which does not copy.
+ */
 template <typename T>
-std::string paint_value(std::string color, T value) {
-  return color + std::to_string(value);
+std::string paint_value(std::string_view color, const T& value) {
+  return std::string{r2d2_format::paint(color, value).view()};
 }
 
+namespace r2d2_async {
+/**
+ * @brief   Writes a formatted line through ROS_DEBUG.
+ *
+ * @param   line The formatted line
+ */
+inline void ros_debug_sink(std::string_view line) {
+  ROS_DEBUG("%.*s", static_cast<int>(line.size()), line.data());
+};
+}  // namespace r2d2_async
+
+/**
+ * @brief   Formats the arguments of a debug macro and logs them through
+ *          ROS_DEBUG.
+ *
+ * @details stream is DEBUG_STREAM_ARGS_OF or DEBUG_STREAM_ARGS_C_OF and names
+ *          the string literal the user-facing macro made of its own
+ *          arguments, so macro arguments are printed by name, not expanded.
+ */
+#define DEBUG_LOG_VARS(stream, color, names, ...) \
+  ROS_DEBUG("%s", stream(color, names, __VA_ARGS__))
+#define DEBUG_LOG_VOID(stream, color, names, ...) \
+  ROS_DEBUG("%s(%s)", __func__, stream(color, names, __VA_ARGS__))
+#define DEBUG_LOG_FUNC(stream, color, output, names, ...)               \
+  ROS_DEBUG("%s(%s) : %s", __func__, stream(color, names, __VA_ARGS__), \
+            r2d2_format::paint(ANSI_WHITE, output).c_str())
+#define DEBUG_LOG_NAMED_VARS(stream, name, color, names, ...) \
+  ROS_DEBUG("[%s] %s", name.c_str(), stream(color, names, __VA_ARGS__))
+#define DEBUG_LOG_NAMED_VOID(stream, name, color, names, ...) \
+  ROS_DEBUG("[%s] %s(%s)", name.c_str(), __func__,            \
+            stream(color, names, __VA_ARGS__))
+#define DEBUG_LOG_NAMED_FUNC(stream, name, color, output, names, ...) \
+  ROS_DEBUG("[%s] %s(%s) : %s", name.c_str(), __func__,               \
+            stream(color, names, __VA_ARGS__),                        \
+            r2d2_format::paint(ANSI_WHITE, output).c_str())
+
+// The plain macros stay synchronous; ROS_DEBUG_ASYNC_* take only arithmetic
+// and enum arguments and log through the asynchronous backend
 #define ROS_DEBUG_VARS(...) \
-  ROS_DEBUG("%s", stream_args(ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__).c_str())
-#define ROS_DEBUG_VOID(...)     \
-  ROS_DEBUG("%s(%s)", __func__, \
-            stream_args(ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__).c_str())
-#define ROS_DEBUG_FUNC(output, ...)                                     \
-  ROS_DEBUG("%s(%s) : %s", __func__,                                    \
-            stream_args(ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__).c_str(), \
-            paint_value(ANSI_WHITE, output).c_str())
-
-#define ROS_DEBUG_VARS_C(...) \
-  ROS_DEBUG("%s", stream_args_c(ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__).data())
-#define ROS_DEBUG_VOID_C(...)   \
-  ROS_DEBUG("%s(%s)", __func__, \
-            stream_args_c(ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__).data())
-#define ROS_DEBUG_FUNC_C(output, ...)                                    \
-  ROS_DEBUG("%s(%s) : %s", __func__,                                     \
-            stream_args_c(ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__).data(), \
-            paint_value(ANSI_WHITE, output).c_str())
-
-#define ROS_DEBUG_NAMED_VARS(name, ...) \
-  ROS_DEBUG("[%s] %s", name.c_str(),    \
-            stream_args(ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__).c_str())
-#define ROS_DEBUG_NAMED_VOID(name, ...)            \
-  ROS_DEBUG("[%s] %s(%s)", name.c_str(), __func__, \
-            stream_args(ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__).c_str())
-#define ROS_DEBUG_NAMED_FUNC(name, output, ...)                         \
-  ROS_DEBUG("[%s] %s(%s) : %s", name.c_str(), __func__,                 \
-            stream_args(ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__).c_str(), \
-            paint_value(ANSI_WHITE, output).c_str())
-
-#define ROS_DEBUG_NAMED_VARS_C(name, ...) \
-  ROS_DEBUG("[%s] %s", name.c_str(),      \
-            stream_args_c(ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__).data())
-#define ROS_DEBUG_NAMED_VOID_C(name, ...)          \
-  ROS_DEBUG("[%s] %s(%s)", name.c_str(), __func__, \
-            stream_args_c(ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__).data())
+  DEBUG_LOG_VARS(DEBUG_STREAM_ARGS_OF, ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__)
+#define ROS_DEBUG_VOID(...) \
+  DEBUG_LOG_VOID(DEBUG_STREAM_ARGS_OF, ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__)
+#define ROS_DEBUG_FUNC(output, ...)                                      \
+  DEBUG_LOG_FUNC(DEBUG_STREAM_ARGS_OF, ANSI_WHITE, output, #__VA_ARGS__, \
+                 __VA_ARGS__)
+
+#define ROS_DEBUG_NAMED_VARS(name, ...)                                      \
+  DEBUG_LOG_NAMED_VARS(DEBUG_STREAM_ARGS_OF, name, ANSI_WHITE, #__VA_ARGS__, \
+                       __VA_ARGS__)
+#define ROS_DEBUG_NAMED_VOID(name, ...)                                      \
+  DEBUG_LOG_NAMED_VOID(DEBUG_STREAM_ARGS_OF, name, ANSI_WHITE, #__VA_ARGS__, \
+                       __VA_ARGS__)
+#define ROS_DEBUG_NAMED_FUNC(name, output, ...)                        \
+  DEBUG_LOG_NAMED_FUNC(DEBUG_STREAM_ARGS_OF, name, ANSI_WHITE, output, \
+                       #__VA_ARGS__, __VA_ARGS__)
+
+// Scope latency histograms, reported as p50/p99/max through ROS_DEBUG
+#define ROS_DEBUG_SCOPE(name) DEBUG_SCOPE_TIMER(name)
+#define ROS_DEBUG_SCOPE_FUNC() DEBUG_SCOPE_TIMER(__func__)
+#define ROS_DEBUG_SCOPE_REPORT()                      \
+  r2d2_latency::report([](const std::string& line_) { \
+    ROS_DEBUG("%s", line_.c_str());                   \
+  })
+#define ROS_DEBUG_SCOPE_REPORT_EVERY(period)                        \
+  r2d2_latency::report_every(period, [](const std::string& line_) { \
+    ROS_DEBUG("%s", line_.c_str());                                 \
+  })
+
+#define ROS_DEBUG_VARS_C(...)                                      \
+  DEBUG_LOG_VARS(DEBUG_STREAM_ARGS_C_OF, ANSI_WHITE, #__VA_ARGS__, \
+                 __VA_ARGS__)
+#define ROS_DEBUG_VOID_C(...)                                      \
+  DEBUG_LOG_VOID(DEBUG_STREAM_ARGS_C_OF, ANSI_WHITE, #__VA_ARGS__, \
+                 __VA_ARGS__)
+#define ROS_DEBUG_FUNC_C(output, ...)                                      \
+  DEBUG_LOG_FUNC(DEBUG_STREAM_ARGS_C_OF, ANSI_WHITE, output, #__VA_ARGS__, \
+                 __VA_ARGS__)
+
+#define ROS_DEBUG_NAMED_VARS_C(name, ...)                                      \
+  DEBUG_LOG_NAMED_VARS(DEBUG_STREAM_ARGS_C_OF, name, ANSI_WHITE, #__VA_ARGS__, \
+                       __VA_ARGS__)
+#define ROS_DEBUG_NAMED_VOID_C(name, ...)                                      \
+  DEBUG_LOG_NAMED_VOID(DEBUG_STREAM_ARGS_C_OF, name, ANSI_WHITE, #__VA_ARGS__, \
+                       __VA_ARGS__)
 #define ROS_DEBUG_NAMED_FUNC_C(name, output, ...)                        \
-  ROS_DEBUG("[%s] %s(%s) : %s", name.c_str(), __func__,                  \
-            stream_args_c(ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__).data(), \
-            paint_value(ANSI_WHITE, output).c_str())
+  DEBUG_LOG_NAMED_FUNC(DEBUG_STREAM_ARGS_C_OF, name, ANSI_WHITE, output, \
+                       #__VA_ARGS__, __VA_ARGS__)
 
 #define ROS_DEBUG_COLORED_VARS(color, ...) \
-  ROS_DEBUG("%s", stream_args(color, #__VA_ARGS__, __VA_ARGS__).c_str())
+  DEBUG_LOG_VARS(DEBUG_STREAM_ARGS_OF, color, #__VA_ARGS__, __VA_ARGS__)
 #define ROS_DEBUG_COLORED_VOID(color, ...) \
-  ROS_DEBUG("%s(%s)", __func__,            \
-            stream_args(color, #__VA_ARGS__, __VA_ARGS__).c_str())
-#define ROS_DEBUG_COLORED_FUNC(color, output, ...)                 \
-  ROS_DEBUG("%s(%s) : %s", __func__,                               \
-            stream_args(color, #__VA_ARGS__, __VA_ARGS__).c_str(), \
-            paint_value(ANSI_WHITE, output).c_str())
+  DEBUG_LOG_VOID(DEBUG_STREAM_ARGS_OF, color, #__VA_ARGS__, __VA_ARGS__)
+#define ROS_DEBUG_COLORED_FUNC(color, output, ...)                  \
+  DEBUG_LOG_FUNC(DEBUG_STREAM_ARGS_OF, color, output, #__VA_ARGS__, \
+                 __VA_ARGS__)
 
 #define ROS_DEBUG_COLORED_VARS_C(color, ...) \
-  ROS_DEBUG("%s", stream_args_c(color, #__VA_ARGS__, __VA_ARGS__).data())
+  DEBUG_LOG_VARS(DEBUG_STREAM_ARGS_C_OF, color, #__VA_ARGS__, __VA_ARGS__)
 #define ROS_DEBUG_COLORED_VOID_C(color, ...) \
-  ROS_DEBUG("%s(%s)", __func__,              \
-            stream_args_c(color, #__VA_ARGS__, __VA_ARGS__).data())
-#define ROS_DEBUG_COLORED_FUNC_C(color, output, ...)                \
-  ROS_DEBUG("%s(%s) : %s", __func__,                                \
-            stream_args_c(color, #__VA_ARGS__, __VA_ARGS__).data(), \
-            paint_value(ANSI_WHITE, output).c_str())
-
-#define ROS_DEBUG_NAMED_COLORED_VARS(name, color, ...) \
-  ROS_DEBUG("[%s] %s", name.c_str(),                   \
-            stream_args(color, #__VA_ARGS__, __VA_ARGS__).c_str())
-#define ROS_DEBUG_NAMED_COLORED_VOID(name, color, ...) \
-  ROS_DEBUG("[%s] %s(%s)", name.c_str(), __func__,     \
-            stream_args(color, #__VA_ARGS__, __VA_ARGS__).c_str())
-#define ROS_DEBUG_NAMED_COLORED_FUNC(name, color, output, ...)     \
-  ROS_DEBUG("[%s] %s(%s) : %s", name.c_str(), __func__,            \
-            stream_args(color, #__VA_ARGS__, __VA_ARGS__).c_str(), \
-            paint_value(ANSI_WHITE, output).c_str())
-
-#define ROS_DEBUG_NAMED_COLORED_VARS_C(name, color, ...) \
-  ROS_DEBUG("[%s] %s", name.c_str(),                     \
-            stream_args_c(color, #__VA_ARGS__, __VA_ARGS__).data())
-#define ROS_DEBUG_NAMED_COLORED_VOID_C(name, color, ...) \
-  ROS_DEBUG("[%s] %s(%s)", name.c_str(), __func__,       \
-            stream_args_c(color, #__VA_ARGS__, __VA_ARGS__).data())
+  DEBUG_LOG_VOID(DEBUG_STREAM_ARGS_C_OF, color, #__VA_ARGS__, __VA_ARGS__)
+#define ROS_DEBUG_COLORED_FUNC_C(color, output, ...)                  \
+  DEBUG_LOG_FUNC(DEBUG_STREAM_ARGS_C_OF, color, output, #__VA_ARGS__, \
+                 __VA_ARGS__)
+
+#define ROS_DEBUG_NAMED_COLORED_VARS(name, color, ...)                  \
+  DEBUG_LOG_NAMED_VARS(DEBUG_STREAM_ARGS_OF, name, color, #__VA_ARGS__, \
+                       __VA_ARGS__)
+#define ROS_DEBUG_NAMED_COLORED_VOID(name, color, ...)                  \
+  DEBUG_LOG_NAMED_VOID(DEBUG_STREAM_ARGS_OF, name, color, #__VA_ARGS__, \
+                       __VA_ARGS__)
+#define ROS_DEBUG_NAMED_COLORED_FUNC(name, color, output, ...)    \
+  DEBUG_LOG_NAMED_FUNC(DEBUG_STREAM_ARGS_OF, name, color, output, \
+                       #__VA_ARGS__, __VA_ARGS__)
+
+#define ROS_DEBUG_NAMED_COLORED_VARS_C(name, color, ...)                  \
+  DEBUG_LOG_NAMED_VARS(DEBUG_STREAM_ARGS_C_OF, name, color, #__VA_ARGS__, \
+                       __VA_ARGS__)
+#define ROS_DEBUG_NAMED_COLORED_VOID_C(name, color, ...)                  \
+  DEBUG_LOG_NAMED_VOID(DEBUG_STREAM_ARGS_C_OF, name, color, #__VA_ARGS__, \
+                       __VA_ARGS__)
 #define ROS_DEBUG_NAMED_COLORED_FUNC_C(name, color, output, ...)    \
-  ROS_DEBUG("[%s] %s(%s) : %s", name.c_str(), __func__,             \
-            stream_args_c(color, #__VA_ARGS__, __VA_ARGS__).data(), \
-            paint_value(ANSI_WHITE, output).c_str())
+  DEBUG_LOG_NAMED_FUNC(DEBUG_STREAM_ARGS_C_OF, name, color, output, \
+                       #__VA_ARGS__, __VA_ARGS__)
+
+// At most once per period (in seconds) per call site
+#define ROS_DEBUG_VARS_THROTTLE(period, ...)                              \
+  DEBUG_THROTTLE(period, DEBUG_LOG_VARS(DEBUG_STREAM_ARGS_OF, ANSI_WHITE, \
+                                        #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_VOID_THROTTLE(period, ...)                              \
+  DEBUG_THROTTLE(period, DEBUG_LOG_VOID(DEBUG_STREAM_ARGS_OF, ANSI_WHITE, \
+                                        #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_FUNC_THROTTLE(period, output, ...)                      \
+  DEBUG_THROTTLE(period, DEBUG_LOG_FUNC(DEBUG_STREAM_ARGS_OF, ANSI_WHITE, \
+                                        output, #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_VARS_THROTTLE(period, name, ...)                  \
+  DEBUG_THROTTLE(period, DEBUG_LOG_NAMED_VARS(DEBUG_STREAM_ARGS_OF, name, \
+                                              ANSI_WHITE, #__VA_ARGS__,   \
+                                              __VA_ARGS__))
+#define ROS_DEBUG_NAMED_VOID_THROTTLE(period, name, ...)                  \
+  DEBUG_THROTTLE(period, DEBUG_LOG_NAMED_VOID(DEBUG_STREAM_ARGS_OF, name, \
+                                              ANSI_WHITE, #__VA_ARGS__,   \
+                                              __VA_ARGS__))
+#define ROS_DEBUG_NAMED_FUNC_THROTTLE(period, name, output, ...)          \
+  DEBUG_THROTTLE(period, DEBUG_LOG_NAMED_FUNC(DEBUG_STREAM_ARGS_OF, name, \
+                                              ANSI_WHITE, output,         \
+                                              #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_COLORED_VARS_THROTTLE(period, color, ...)          \
+  DEBUG_THROTTLE(period, DEBUG_LOG_VARS(DEBUG_STREAM_ARGS_OF, color, \
+                                        #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_COLORED_VOID_THROTTLE(period, color, ...)          \
+  DEBUG_THROTTLE(period, DEBUG_LOG_VOID(DEBUG_STREAM_ARGS_OF, color, \
+                                        #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_COLORED_FUNC_THROTTLE(period, color, output, ...)          \
+  DEBUG_THROTTLE(period, DEBUG_LOG_FUNC(DEBUG_STREAM_ARGS_OF, color, output, \
+                                        #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_COLORED_VARS_THROTTLE(period, name, color, ...)   \
+  DEBUG_THROTTLE(period, DEBUG_LOG_NAMED_VARS(DEBUG_STREAM_ARGS_OF, name, \
+                                              color, #__VA_ARGS__,        \
+                                              __VA_ARGS__))
+#define ROS_DEBUG_NAMED_COLORED_VOID_THROTTLE(period, name, color, ...)   \
+  DEBUG_THROTTLE(period, DEBUG_LOG_NAMED_VOID(DEBUG_STREAM_ARGS_OF, name, \
+                                              color, #__VA_ARGS__,        \
+                                              __VA_ARGS__))
+#define ROS_DEBUG_NAMED_COLORED_FUNC_THROTTLE(period, name, color, output, \
+                                              ...)                         \
+  DEBUG_THROTTLE(period, DEBUG_LOG_NAMED_FUNC(DEBUG_STREAM_ARGS_OF, name,  \
+                                              color, output, #__VA_ARGS__, \
+                                              __VA_ARGS__))
+
+#define ROS_DEBUG_VARS_THROTTLE_C(period, ...)                              \
+  DEBUG_THROTTLE(period, DEBUG_LOG_VARS(DEBUG_STREAM_ARGS_C_OF, ANSI_WHITE, \
+                                        #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_VOID_THROTTLE_C(period, ...)                              \
+  DEBUG_THROTTLE(period, DEBUG_LOG_VOID(DEBUG_STREAM_ARGS_C_OF, ANSI_WHITE, \
+                                        #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_FUNC_THROTTLE_C(period, output, ...)                      \
+  DEBUG_THROTTLE(period, DEBUG_LOG_FUNC(DEBUG_STREAM_ARGS_C_OF, ANSI_WHITE, \
+                                        output, #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_VARS_THROTTLE_C(period, name, ...)                  \
+  DEBUG_THROTTLE(period, DEBUG_LOG_NAMED_VARS(DEBUG_STREAM_ARGS_C_OF, name, \
+                                              ANSI_WHITE, #__VA_ARGS__,     \
+                                              __VA_ARGS__))
+#define ROS_DEBUG_NAMED_VOID_THROTTLE_C(period, name, ...)                  \
+  DEBUG_THROTTLE(period, DEBUG_LOG_NAMED_VOID(DEBUG_STREAM_ARGS_C_OF, name, \
+                                              ANSI_WHITE, #__VA_ARGS__,     \
+                                              __VA_ARGS__))
+#define ROS_DEBUG_NAMED_FUNC_THROTTLE_C(period, name, output, ...)          \
+  DEBUG_THROTTLE(period, DEBUG_LOG_NAMED_FUNC(DEBUG_STREAM_ARGS_C_OF, name, \
+                                              ANSI_WHITE, output,           \
+                                              #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_COLORED_VARS_THROTTLE_C(period, color, ...)          \
+  DEBUG_THROTTLE(period, DEBUG_LOG_VARS(DEBUG_STREAM_ARGS_C_OF, color, \
+                                        #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_COLORED_VOID_THROTTLE_C(period, color, ...)          \
+  DEBUG_THROTTLE(period, DEBUG_LOG_VOID(DEBUG_STREAM_ARGS_C_OF, color, \
+                                        #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_COLORED_FUNC_THROTTLE_C(period, color, output, ...)  \
+  DEBUG_THROTTLE(period, DEBUG_LOG_FUNC(DEBUG_STREAM_ARGS_C_OF, color, \
+                                        output, #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_COLORED_VARS_THROTTLE_C(period, name, color, ...)   \
+  DEBUG_THROTTLE(period, DEBUG_LOG_NAMED_VARS(DEBUG_STREAM_ARGS_C_OF, name, \
+                                              color, #__VA_ARGS__,          \
+                                              __VA_ARGS__))
+#define ROS_DEBUG_NAMED_COLORED_VOID_THROTTLE_C(period, name, color, ...)   \
+  DEBUG_THROTTLE(period, DEBUG_LOG_NAMED_VOID(DEBUG_STREAM_ARGS_C_OF, name, \
+                                              color, #__VA_ARGS__,          \
+                                              __VA_ARGS__))
+#define ROS_DEBUG_NAMED_COLORED_FUNC_THROTTLE_C(period, name, color, output, \
+                                                ...)                         \
+  DEBUG_THROTTLE(period, DEBUG_LOG_NAMED_FUNC(DEBUG_STREAM_ARGS_C_OF, name,  \
+                                              color, output, #__VA_ARGS__,   \
+                                              __VA_ARGS__))
+
+// First and every n-th call per call site
+#define ROS_DEBUG_VARS_SAMPLE(n, ...)                              \
+  DEBUG_SAMPLE(n, DEBUG_LOG_VARS(DEBUG_STREAM_ARGS_OF, ANSI_WHITE, \
+                                 #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_VOID_SAMPLE(n, ...)                              \
+  DEBUG_SAMPLE(n, DEBUG_LOG_VOID(DEBUG_STREAM_ARGS_OF, ANSI_WHITE, \
+                                 #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_FUNC_SAMPLE(n, output, ...)                              \
+  DEBUG_SAMPLE(n, DEBUG_LOG_FUNC(DEBUG_STREAM_ARGS_OF, ANSI_WHITE, output, \
+                                 #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_VARS_SAMPLE(n, name, ...)                  \
+  DEBUG_SAMPLE(n, DEBUG_LOG_NAMED_VARS(DEBUG_STREAM_ARGS_OF, name, \
+                                       ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_VOID_SAMPLE(n, name, ...)                  \
+  DEBUG_SAMPLE(n, DEBUG_LOG_NAMED_VOID(DEBUG_STREAM_ARGS_OF, name, \
+                                       ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_FUNC_SAMPLE(n, name, output, ...)                \
+  DEBUG_SAMPLE(n, DEBUG_LOG_NAMED_FUNC(DEBUG_STREAM_ARGS_OF, name,       \
+                                       ANSI_WHITE, output, #__VA_ARGS__, \
+                                       __VA_ARGS__))
+#define ROS_DEBUG_COLORED_VARS_SAMPLE(n, color, ...)                        \
+  DEBUG_SAMPLE(n, DEBUG_LOG_VARS(DEBUG_STREAM_ARGS_OF, color, #__VA_ARGS__, \
+                                 __VA_ARGS__))
+#define ROS_DEBUG_COLORED_VOID_SAMPLE(n, color, ...)                        \
+  DEBUG_SAMPLE(n, DEBUG_LOG_VOID(DEBUG_STREAM_ARGS_OF, color, #__VA_ARGS__, \
+                                 __VA_ARGS__))
+#define ROS_DEBUG_COLORED_FUNC_SAMPLE(n, color, output, ...)          \
+  DEBUG_SAMPLE(n, DEBUG_LOG_FUNC(DEBUG_STREAM_ARGS_OF, color, output, \
+                                 #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_COLORED_VARS_SAMPLE(n, name, color, ...)          \
+  DEBUG_SAMPLE(n, DEBUG_LOG_NAMED_VARS(DEBUG_STREAM_ARGS_OF, name, color, \
+                                       #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_COLORED_VOID_SAMPLE(n, name, color, ...)          \
+  DEBUG_SAMPLE(n, DEBUG_LOG_NAMED_VOID(DEBUG_STREAM_ARGS_OF, name, color, \
+                                       #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_COLORED_FUNC_SAMPLE(n, name, color, output, ...)  \
+  DEBUG_SAMPLE(n, DEBUG_LOG_NAMED_FUNC(DEBUG_STREAM_ARGS_OF, name, color, \
+                                       output, #__VA_ARGS__, __VA_ARGS__))
+
+#define ROS_DEBUG_VARS_SAMPLE_C(n, ...)                              \
+  DEBUG_SAMPLE(n, DEBUG_LOG_VARS(DEBUG_STREAM_ARGS_C_OF, ANSI_WHITE, \
+                                 #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_VOID_SAMPLE_C(n, ...)                              \
+  DEBUG_SAMPLE(n, DEBUG_LOG_VOID(DEBUG_STREAM_ARGS_C_OF, ANSI_WHITE, \
+                                 #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_FUNC_SAMPLE_C(n, output, ...)                              \
+  DEBUG_SAMPLE(n, DEBUG_LOG_FUNC(DEBUG_STREAM_ARGS_C_OF, ANSI_WHITE, output, \
+                                 #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_VARS_SAMPLE_C(n, name, ...)                  \
+  DEBUG_SAMPLE(n, DEBUG_LOG_NAMED_VARS(DEBUG_STREAM_ARGS_C_OF, name, \
+                                       ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_VOID_SAMPLE_C(n, name, ...)                  \
+  DEBUG_SAMPLE(n, DEBUG_LOG_NAMED_VOID(DEBUG_STREAM_ARGS_C_OF, name, \
+                                       ANSI_WHITE, #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_FUNC_SAMPLE_C(n, name, output, ...)              \
+  DEBUG_SAMPLE(n, DEBUG_LOG_NAMED_FUNC(DEBUG_STREAM_ARGS_C_OF, name,     \
+                                       ANSI_WHITE, output, #__VA_ARGS__, \
+                                       __VA_ARGS__))
+#define ROS_DEBUG_COLORED_VARS_SAMPLE_C(n, color, ...)                        \
+  DEBUG_SAMPLE(n, DEBUG_LOG_VARS(DEBUG_STREAM_ARGS_C_OF, color, #__VA_ARGS__, \
+                                 __VA_ARGS__))
+#define ROS_DEBUG_COLORED_VOID_SAMPLE_C(n, color, ...)                        \
+  DEBUG_SAMPLE(n, DEBUG_LOG_VOID(DEBUG_STREAM_ARGS_C_OF, color, #__VA_ARGS__, \
+                                 __VA_ARGS__))
+#define ROS_DEBUG_COLORED_FUNC_SAMPLE_C(n, color, output, ...)          \
+  DEBUG_SAMPLE(n, DEBUG_LOG_FUNC(DEBUG_STREAM_ARGS_C_OF, color, output, \
+                                 #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_COLORED_VARS_SAMPLE_C(n, name, color, ...)          \
+  DEBUG_SAMPLE(n, DEBUG_LOG_NAMED_VARS(DEBUG_STREAM_ARGS_C_OF, name, color, \
+                                       #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_COLORED_VOID_SAMPLE_C(n, name, color, ...)          \
+  DEBUG_SAMPLE(n, DEBUG_LOG_NAMED_VOID(DEBUG_STREAM_ARGS_C_OF, name, color, \
+                                       #__VA_ARGS__, __VA_ARGS__))
+#define ROS_DEBUG_NAMED_COLORED_FUNC_SAMPLE_C(n, name, color, output, ...)  \
+  DEBUG_SAMPLE(n, DEBUG_LOG_NAMED_FUNC(DEBUG_STREAM_ARGS_C_OF, name, color, \
+                                       output, #__VA_ARGS__, __VA_ARGS__))
 
 #endif  // INCLUDE_R2D2_UTILS_PKG_CUSTOM_HPP_
@@ -2,12 +2,141 @@
 #define INCLUDE_R2D2_UTILS_PKG_DEBUG_HPP_
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <iterator>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Console.hpp"
+#include "Format.hpp"
+
+/**
+ * @brief   Splits the stringified arguments of a debug macro once per call
+ *          site.
+ *
+ * @param   names The arguments as a string literal
+ *
+ * @details Expands to a reference to a function-local static constexpr
+ *          VarNames, so the names are parsed at compile time and every later
+ *          call only formats the values. The string must be made with # by
+ *          the macro the user calls: arguments forwarded through another
+ *          macro level are expanded first, so a macro argument would print as
+ *          its value.
+ */
+#define DEBUG_VAR_NAMES_OF(names)                              \
+  []() -> const VarNames& {                                    \
+    static constexpr VarNames names_{std::string_view{names}}; \
+    return names_;                                             \
+  }()
+#define DEBUG_VAR_NAMES(...) DEBUG_VAR_NAMES_OF(#__VA_ARGS__)
+
+/**
+ * @brief   Formats the arguments of a debug macro as "name = value" pairs.
+ *
+ * @param   color ANSI color code
+ * @param   names The arguments as a string literal, see DEBUG_VAR_NAMES_OF
+ * @return        Null-terminated C string valid until the end of the full
+ *                expression
+ */
+#define DEBUG_STREAM_ARGS_OF(color, names, ...)                               \
+  stream_args_into(r2d2_format::format_buffer(r2d2_format::FormatSlot::ARGS), \
+                   color, DEBUG_VAR_NAMES_OF(names), __VA_ARGS__)
+#define DEBUG_STREAM_ARGS(color, ...) \
+  DEBUG_STREAM_ARGS_OF(color, #__VA_ARGS__, __VA_ARGS__)
+
+constexpr std::size_t MAX_VAR_NAMES{16};
+
+/**
+ * @brief   Fixed-capacity list of variable names split from a macro argument
+ *          string.
+ *
+ * @details Names are views into the original string, split at top-level
+ *          commas (commas inside parentheses, brackets, braces or quotes do
+ *          not split) and trimmed of surrounding whitespace. Names beyond
+ *          MAX_VAR_NAMES are counted but not stored.
+ */
+class VarNames {
+ private:
+  std::array<std::string_view, MAX_VAR_NAMES> m_names{};
+  std::size_t m_count{0};
+
+  constexpr VarNames() = default;
+
+ public:
+  /**
+   * @brief   Splits a comma-separated string of variable names.
+   *
+   * @param   var_str The stringified macro arguments
+   */
+  constexpr explicit VarNames(std::string_view var_str) {
+    std::size_t depth_{0}, start_{0};
+    char quote_{'\0'};
+    for (std::size_t i = 0; i <= var_str.size(); ++i) {
+      const char chr_{i < var_str.size() ? var_str[i] : ','};
+      if (quote_ != '\0') {
+        if (chr_ == '\\') ++i;
+        else if (chr_ == quote_) quote_ = '\0';
+        continue;
+      }
+      if (chr_ == '"' || chr_ == '\'') quote_ = chr_;
+      else if (chr_ == '(' || chr_ == '[' || chr_ == '{') ++depth_;
+      else if ((chr_ == ')' || chr_ == ']' || chr_ == '}') && depth_ > 0)
+        --depth_;
+      else if (chr_ == ',' && depth_ == 0) {
+        push(trim(var_str.substr(start_, i - start_)));
+        start_ = i + 1;
+      }
+    }
+  };
+
+  /**
+   * @brief   Gets the number of names.
+   *
+   * @return  The number of split names
+   */
+  [[nodiscard]] constexpr std::size_t size() const { return m_count; };
+
+  /**
+   * @brief   Gets a name by index.
+   *
+   * @param   idx The name index
+   * @return      The name, or an empty view if idx is out of range
+   */
+  [[nodiscard]] constexpr std::string_view operator[](std::size_t idx) const {
+    return idx < m_count && idx < MAX_VAR_NAMES ? m_names[idx]
+                                                : std::string_view{};
+  };
+
+  /**
+   * @brief   Gets the names without the first one.
+   *
+   * @return  A copy holding every name but the first
+   */
+  [[nodiscard]] constexpr VarNames tail() const {
+    VarNames result_{};
+    for (std::size_t i = 1; i < m_count; ++i) result_.push((*this)[i]);
+    return result_;
+  };
+
+ private:
+  constexpr void push(std::string_view name) {
+    if (m_count < MAX_VAR_NAMES) m_names[m_count] = name;
+    ++m_count;
+  };
+
+  static constexpr std::string_view trim(std::string_view str) {
+    while (!str.empty() && is_space(str.front())) str.remove_prefix(1);
+    while (!str.empty() && is_space(str.back())) str.remove_suffix(1);
+    return str;
+  };
+
+  static constexpr bool is_space(char chr) {
+    return chr == ' ' || chr == '\t' || chr == '\n' || chr == '\r';
+  };
+};
 
 /**
  * @brief   Parses a variable string into a vector of variable names.
@@ -28,31 +157,79 @@ inline auto parse_var_str(std::string_view var_str) {
 };
 
 /**
- * @brief   Streams a single variable with its name and value to an
- *          output stream.
+ * @brief   Appends a single variable with its name and value to a format
+ *          buffer.
  *
  * @tparam  T     Variable type
- * @param   oss   The output string stream
+ * @param   buf   The format buffer
  * @param   color ANSI color code for the variable name
  * @param   name  The variable name
  * @param   arg   The variable value
  * @param   idx   Current index in the variable list
  * @param   sz    Total number of variables
- * @return        Reference to the output stream
+ * @return        Reference to the format buffer
  *
  * @details If the variable name is empty, does not print anything. Otherwise,
  *          prints the variable name and value, followed by a comma if the name
  *          is not the last.
  */
 template <typename T>
-inline std::ostringstream& stream_var(std::ostringstream& oss,
-                                      std::string_view color,
-                                      std::string_view name, T&& arg,
-                                      std::size_t idx, std::size_t sz) {
-  if (name == "\"\"") return oss;
-  oss << color << name << " = " << std::forward<T>(arg) << ANSI_RESET;
-  if (idx + 1 < sz) oss << ", ";
-  return oss;
+inline r2d2_format::FormatBuffer& stream_var(r2d2_format::FormatBuffer& buf,
+                                             std::string_view color,
+                                             std::string_view name,
+                                             const T& arg, std::size_t idx,
+                                             std::size_t sz) {
+  if (name == "\"\"") return buf;
+  buf.append(color).append(name).append(" = ").append_value(arg).append(
+      ANSI_RESET);
+  if (idx + 1 < sz) buf.append(", ");
+  return buf;
+};
+
+/**
+ * @brief   Formats multiple variables with their pre-split names and values
+ *          into a format buffer.
+ *
+ * @tparam  Args  Variadic variable types
+ * @param   buf   The format buffer, usually a thread-local one
+ * @param   color ANSI color code for variable names
+ * @param   names Variable names, usually from DEBUG_VAR_NAMES
+ * @param   args  The variable values
+ * @return        Null-terminated C string owned by the buffer
+ *
+ * @details This is the runtime path of the ROS_DEBUG macros. Once the buffer
+ *          has grown to the longest line, formatting does not allocate.
+ */
+template <typename... Args>
+inline const char* stream_args_into(r2d2_format::FormatBuffer& buf,
+                                    std::string_view color,
+                                    const VarNames& names,
+                                    const Args&... args) {
+  std::size_t idx{0};
+  constexpr std::size_t sz{sizeof...(args)};
+  ((stream_var(buf, color, names[idx], args, idx, sz), idx++), ...);
+  return buf.c_str();
+};
+
+/**
+ * @brief   Streams multiple variables with their pre-split names and values.
+ *
+ * @tparam  Args  Variadic variable types
+ * @param   color ANSI color code for variable names
+ * @param   names Variable names, usually from DEBUG_VAR_NAMES
+ * @param   args  The variable values
+ * @return        Formatted string with "name = value" pairs, separated by
+ *                commas
+ *
+ * @details Formats into the thread-local ARGS buffer and copies the result
+ *          out; prefer DEBUG_STREAM_ARGS, which does not copy.
+ */
+template <typename... Args>
+inline std::string stream_args(std::string_view color, const VarNames& names,
+                               const Args&... args) {
+  return std::string{stream_args_into(
+      r2d2_format::format_buffer(r2d2_format::FormatSlot::ARGS), color, names,
+      args...)};
 };
 
 /**
@@ -65,20 +242,12 @@ inline std::ostringstream& stream_var(std::ostringstream& oss,
  * @return        Formatted string with "name = value" pairs, separated by
  *                commas
  *
- * @details This is the runtime version of stream_args, used by ROS_DEBUG_STREAM
- *          macros. Formats all variables with their names and values.
+ * @details Splits the names on every call; prefer passing DEBUG_VAR_NAMES.
  */
 template <typename... Args>
 inline std::string stream_args(std::string_view color, std::string_view names,
-                               Args&&... args) {
-  std::ostringstream oss;
-  auto var_names_{parse_var_str(names)};
-  std::size_t idx{0};
-  constexpr std::size_t sz{sizeof...(args)};
-  ((stream_var(oss, color, var_names_[idx], std::forward<Args>(args), idx, sz),
-    idx++),
-   ...);
-  return oss.str();
+                               const Args&... args) {
+  return stream_args(color, VarNames{names}, args...);
 };
 
 #endif  // INCLUDE_R2D2_UTILS_PKG_DEBUG_HPP_
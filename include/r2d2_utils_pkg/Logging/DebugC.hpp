@@ -2,15 +2,34 @@
 #define INCLUDE_R2D2_UTILS_PKG_DEBUGC_HPP_
 
 #include <array>
+#include <charconv>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string_view>
 #include <type_traits>
 
 #include "Console.hpp"
+#include "Debug.hpp"
 
+/**
+ * @brief   Formats the arguments of a debug macro as "name = value" pairs into
+ *          a right-sized stack buffer.
+ *
+ * @param   color ANSI color code
+ * @param   names The arguments as a string literal, see DEBUG_VAR_NAMES_OF
+ * @return        Null-terminated C string valid until the end of the full
+ *                expression
+ */
+#define DEBUG_STREAM_ARGS_C_OF(color, names, ...) \
+  stream_args_c(color, DEBUG_VAR_NAMES_OF(names), __VA_ARGS__).data()
+#define DEBUG_STREAM_ARGS_C(color, ...) \
+  DEBUG_STREAM_ARGS_C_OF(color, #__VA_ARGS__, __VA_ARGS__)
+
+constexpr std::size_t MAX_COLOR_LEN{16};
 constexpr std::size_t MAX_NAME_LEN{64};
 constexpr std::size_t MAX_VALUE_LEN{256};
-constexpr std::size_t MAX_RESULT_LEN{1024};
 
 /**
  * @brief   Appends a character to a buffer at the current position.
@@ -26,18 +45,6 @@ constexpr void append_chr(char chr, char* dst, std::size_t& pos) {
   dst[pos++] = chr;
 };
 
-/**
- * @brief   Pushes a character backwards into a buffer (for reverse string
- *          building).
- *
- * @param   chr The character to push
- * @param   dst The destination buffer
- * @param   pos Current position in the buffer (decremented after push)
- */
-constexpr void push_chr(char chr, char* dst, std::size_t& pos) {
-  dst[pos--] = chr;
-};
-
 /**
  * @brief   Null-terminates a string at the current position.
  *
@@ -47,49 +54,40 @@ constexpr void push_chr(char chr, char* dst, std::size_t& pos) {
 constexpr void end_str(char* dst, std::size_t& pos) { dst[pos] = '\0'; };
 
 /**
- * @brief   Converts a number to a null-terminated string in a buffer.
+ * @brief   Copies at most max characters of a string to a buffer at the
+ *          current position.
  *
- * @param   value  The integer value to convert
- * @param   buffer The buffer to write the string to
- * @return         The length of the resulting string
- *                 (excluding null terminator)
- *
- * @details Handles negative numbers and builds the string in reverse before
- *          copying forward.
+ * @param   src The source string
+ * @param   dst The destination buffer
+ * @param   pos Current position in the destination buffer (updated after copy)
+ * @param   max Maximum number of characters to copy
  */
-[[nodiscard]]
-constexpr std::size_t num_to_str(std::int64_t value, char* buffer) {
-  const bool negative{value < 0};
-  if (negative) value = -value;
-
-  std::size_t idx{MAX_VALUE_LEN - 1};
-  do {
-    push_chr('0' + (value % 10), buffer, idx);
-    value /= 10;
-  } while (value != 0 && idx > 0);
-
-  if (negative && idx > 0) push_chr('-', buffer, idx);
-
-  // Copy to the beginning of the buffer
-  std::size_t pos{0};
-  for (std::size_t i = idx + 1; i < MAX_VALUE_LEN; ++i)
-    append_chr(buffer[i], buffer, pos);
-  end_str(buffer, pos);
-  return pos;
+constexpr void copy_str(std::string_view src, char* dst, std::size_t& pos,
+                        std::size_t max) {
+  for (std::size_t i = 0; i < src.size() && i < max; ++i)
+    append_chr(src[i], dst, pos);
 };
 
 /**
- * @brief   Copies a null-terminated string to a buffer at the current position.
- *
- * @param   src The source null-terminated string
- * @param   dst The destination buffer
- * @param   pos Current position in the destination buffer (updated after copy)
+ * @brief   Gets the maximum number of characters copy_arg() writes for a type.
  *
- * @details Copies characters until null terminator or buffer limit is reached.
+ * @tparam  T The argument type
+ * @return    The maximum formatted length
  */
-constexpr void copy_str(const char* src, char* dst, std::size_t& pos) {
-  for (std::size_t i = 0; src[i] && pos < MAX_VALUE_LEN - 1; ++i)
-    append_chr(src[i], dst, pos);
+template <typename T>
+constexpr std::size_t max_value_len() {
+  if constexpr (std::is_enum_v<T>)
+    return max_value_len<std::underlying_type_t<T>>();
+  else if constexpr (std::is_same_v<T, bool>)
+    return 1;
+  else if constexpr (std::is_integral_v<T>)
+    return std::numeric_limits<T>::digits10 + 2;
+  else if constexpr (std::is_floating_point_v<T>)
+    return std::numeric_limits<T>::max_digits10 + 10;
+  else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+    return MAX_VALUE_LEN;
+  else
+    return sizeof("<unknown>") - 1;
 };
 
 /**
@@ -100,159 +98,118 @@ constexpr void copy_str(const char* src, char* dst, std::size_t& pos) {
  * @param   dst The destination buffer
  * @param   pos Current position in the destination buffer (updated after copy)
  *
- * @details Converts numeric/enum types to string, handles other types as
- *          "<unknown>".
+ * @details Writes at most max_value_len<T>() characters. Integers and enums
+ *          are formatted with std::to_chars, floating-point values with
+ *          format_float(), strings are truncated to MAX_VALUE_LEN, other
+ *          types print as "<unknown>".
  */
 template <typename T>
-constexpr void copy_arg(T&& arg, char* dst, std::size_t& pos) {
-  char value_buf[MAX_VALUE_LEN]{};
-  const std::size_t value_len{
-      num_to_str(static_cast<std::int64_t>(arg), value_buf)};
-  for (std::size_t i = 0; i < value_len && pos < MAX_VALUE_LEN - 1; ++i)
-    append_chr(value_buf[i], dst, pos);
-};
-
-/**
- * @brief   Concatenates a source buffer array to a destination buffer.
- *
- * @tparam  SrcSize The size of the source array
- * @param   src     The source array to copy from
- * @param   dst     The destination buffer
- * @param   pos     Current position in the destination buffer
- *                  (updated after copy)
- *
- * @details Copies characters until null terminator or buffer limit is reached.
- */
-template <std::size_t SrcSize>
-constexpr void concat_buff(const std::array<char, SrcSize>& src, char* dst,
-                           std::size_t& pos) {
-  for (std::size_t i = 0; src[i] && pos < MAX_VALUE_LEN - 1; ++i)
-    append_chr(src[i], dst, pos);
+void copy_arg(const T& arg, char* dst, std::size_t& pos) {
+  char* first_{dst + pos};
+  char* last_{first_ + max_value_len<T>() + 1};
+  if constexpr (std::is_enum_v<T>) {
+    copy_arg(static_cast<std::underlying_type_t<T>>(arg), dst, pos);
+  } else if constexpr (std::is_same_v<T, bool>) {
+    append_chr(arg ? '1' : '0', dst, pos);
+  } else if constexpr (std::is_integral_v<T>) {
+    pos += static_cast<std::size_t>(std::to_chars(first_, last_, arg).ptr -
+                                    first_);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    pos += static_cast<std::size_t>(format_float(arg, first_, last_) - first_);
+  } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+    copy_str(std::string_view{arg}, dst, pos, MAX_VALUE_LEN);
+  } else {
+    copy_str("<unknown>", dst, pos, MAX_VALUE_LEN);
+  }
 };
 
 /**
- * @brief   Parses a variable string into an array of variable names at compile
- *          time.
+ * @brief   Gets the buffer size stream_args_c() needs for the given types.
  *
- * @tparam  MaxNames Maximum number of variable names to parse
- * @param   var_str  Comma-separated null-terminated string of variable names
- * @return           Array of null-terminated variable name strings
- *
- * @details Splits the input string by commas and spaces, extracting individual
- *          variable names. Returns empty strings for empty variable names
- *          (indicated by "").
+ * @tparam  Args Variadic variable types
+ * @return       The worst-case formatted length plus the null terminator
  */
-template <std::size_t MaxNames>
-[[nodiscard]]
-constexpr std::array<char[MAX_NAME_LEN], MaxNames> parse_var_str(
-    const char* var_str) {
-  std::array<char[MAX_NAME_LEN], MaxNames> result{};
-  std::size_t count{0}, start{0}, str_len{0};
-
-  while (var_str[str_len] != '\0') ++str_len;
-
-  for (std::size_t i = 0; i <= str_len && count < MaxNames; ++i) {
-    if (i < str_len && var_str[i] != ',' && var_str[i] != ' ') continue;
-
-    while (start < i && (var_str[start] == ' ' || var_str[start] == ','))
-      ++start;
-
-    if (start < i && (i - start) < MAX_NAME_LEN) {
-      std::size_t len = i - start;
-      for (std::size_t j = 0; j < len; ++j)
-        result[count][j] = var_str[start + j];
-      end_str(result[count], len);
-      ++count;
-    }
-    start = i + 1;
-  }
-
-  return result;
+template <typename... Args>
+constexpr std::size_t stream_args_c_len() {
+  constexpr std::size_t var_len_{MAX_COLOR_LEN + MAX_NAME_LEN +
+                                 sizeof(" = ") - 1 + sizeof(ANSI_RESET) - 1 +
+                                 sizeof(", ") - 1};
+  return ((var_len_ + max_value_len<Args>() + 1) + ... + 1);
 };
 
 /**
- * @brief   Creates a formatted string for a single variable at compile time.
+ * @brief   Writes a single "name = value" pair into a buffer in place.
  *
  * @tparam  T     The variable type
  * @param   color ANSI color code for the variable name
- * @param   name  The variable name (null-terminated string)
+ * @param   name  The variable name
  * @param   arg   The variable value
  * @param   idx   Current index in the variable list
  * @param   sz    Total number of variables
- * @return        Array containing the formatted "name = value" string
+ * @param   dst   The destination buffer
+ * @param   pos   Current position in the buffer (updated after write)
  *
  * @details If the variable name is empty, does not print anything. Otherwise,
  *          prints the variable name and value, followed by a comma if the name
  *          is not the last.
  */
 template <typename T>
-[[nodiscard]]
-constexpr std::array<char, MAX_VALUE_LEN> stream_var(const char* color,
-                                                     const char* name,
-                                                     const T& arg,
-                                                     std::size_t idx,
-                                                     std::size_t sz) {
-  std::array<char, MAX_VALUE_LEN> result{};
-  std::size_t pos{0};
-
-  if (name[0] == '"' && name[1] == '"') {
-    end_str(result.data(), pos);
-    return result;
-  }
-
-  copy_str(color, result.data(), pos);
-  copy_str(name, result.data(), pos);
-  copy_str(" = ", result.data(), pos);
-
-  if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
-    copy_arg(arg, result.data(), pos);
-  } else if constexpr (std::is_same_v<std::decay_t<T>, const char*>) {
-    copy_str(arg, result.data(), pos);
-  } else {
-    copy_str("<unknown>", result.data(), pos);
-  }
-
-  copy_str(ANSI_GREEN, result.data(), pos);
-  if (idx + 1 < sz) {
-    append_chr(',', result.data(), pos);
-    append_chr(' ', result.data(), pos);
-  }
-  end_str(result.data(), pos);
-  return result;
+void stream_var(std::string_view color, std::string_view name, const T& arg,
+                std::size_t idx, std::size_t sz, char* dst, std::size_t& pos) {
+  if (name == "\"\"") return;
+  copy_str(color, dst, pos, MAX_COLOR_LEN);
+  copy_str(name, dst, pos, MAX_NAME_LEN);
+  copy_str(" = ", dst, pos, MAX_NAME_LEN);
+  copy_arg(arg, dst, pos);
+  copy_str(ANSI_RESET, dst, pos, MAX_COLOR_LEN);
+  if (idx + 1 < sz) copy_str(", ", dst, pos, MAX_NAME_LEN);
 };
 
 /**
- * @brief   Creates a formatted string for multiple variables at compile time.
+ * @brief   Creates a formatted string for multiple variables in a single
+ *          right-sized buffer.
  *
  * @tparam  Args  Variadic variable types
  * @param   color ANSI color code for variable names
- * @param   names Comma-separated null-terminated string of variable names
+ * @param   names Variable names, usually from DEBUG_VAR_NAMES
  * @param   args  The variable values
  * @return        Array containing the formatted string with "name = value"
  *                pairs, separated by commas
  *
- * @details This is the compile-time (constexpr) version of stream_args, used by
- *          ROS_DEBUG macros that require compile-time evaluation. Formats all
- *          variables with their names and values.
+ * @details This is the allocation-free version of stream_args. The buffer size
+ *          is computed from the argument types at compile time and every pair
+ *          is written in place, so nothing is zero-initialized or copied
+ *          twice. Colors longer than MAX_COLOR_LEN and names longer than
+ *          MAX_NAME_LEN are truncated.
  */
 template <typename... Args>
-constexpr std::array<char, MAX_RESULT_LEN> stream_args_c(const char* color,
-                                                         const char* names,
-                                                         const Args&... args) {
+std::array<char, stream_args_c_len<Args...>()> stream_args_c(
+    std::string_view color, const VarNames& names, const Args&... args) {
   constexpr std::size_t sz{sizeof...(Args)};
-  auto var_names{parse_var_str<sz>(names)};
-
-  std::array<char, MAX_RESULT_LEN> result{};
+  std::array<char, stream_args_c_len<Args...>()> result;
   std::size_t pos{0}, idx{0};
-
-  auto append_var = [&](const auto& arg) {
-    concat_buff(stream_var(color, var_names[idx], arg, idx, sz), result.data(),
-                pos);
-    ++idx;
-  };
-  (append_var(args), ...);
+  ((stream_var(color, names[idx], args, idx, sz, result.data(), pos), ++idx),
+   ...);
   end_str(result.data(), pos);
   return result;
 };
 
+/**
+ * @brief   Creates a formatted string for multiple variables in a single
+ *          right-sized buffer.
+ *
+ * @tparam  Args  Variadic variable types
+ * @param   color ANSI color code for variable names
+ * @param   names Comma-separated string of variable names
+ * @param   args  The variable values
+ * @return        Array containing the formatted string
+ *
+ * @details Splits the names on every call; prefer passing DEBUG_VAR_NAMES.
+ */
+template <typename... Args>
+std::array<char, stream_args_c_len<Args...>()> stream_args_c(
+    std::string_view color, std::string_view names, const Args&... args) {
+  return stream_args_c(color, VarNames{names}, args...);
+};
+
 #endif  // INCLUDE_R2D2_UTILS_PKG_DEBUGC_HPP_
@@ -0,0 +1,243 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_FORMAT_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_FORMAT_HPP_
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief   Formats a floating-point value in its shortest round-trip form.
+ *
+ * @tparam  T     Floating-point type
+ * @param   value The value to format
+ * @param   first Start of the destination range
+ * @param   last  End of the destination range
+ * @return        Pointer past the last written character
+ *
+ * @details Uses std::to_chars where the standard library provides it for
+ *          floating-point types, snprintf with max_digits10 otherwise.
+ */
+template <typename T>
+char* format_float(T value, char* first, char* last) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  return std::to_chars(first, last, value).ptr;
+#else
+  const int len_{std::snprintf(first, static_cast<std::size_t>(last - first),
+                               "%.*Lg", std::numeric_limits<T>::max_digits10,
+                               static_cast<long double>(value))};
+  return len_ > 0 ? first + len_ : first;
+#endif
+};
+
+namespace r2d2_format {
+constexpr std::size_t FORMAT_BUFFER_RESERVE{512};
+constexpr std::size_t FORMAT_NUMBER_LEN{64};
+constexpr std::size_t FORMAT_BUFFER_DEPTH{4};
+
+/**
+ * @brief   Growable text buffer that keeps its capacity between uses.
+ *
+ * @details clear() only resets the length, so once a buffer has grown to
+ *          the longest line of a thread, formatting into it no longer
+ *          allocates. Arithmetic values, enums and strings are formatted
+ *          without allocating; other types go through a reused thread-local
+ *          ostringstream, or a local one if that stream is in use.
+ */
+class FormatBuffer {
+ private:
+  std::string m_text{};
+
+ public:
+  FormatBuffer() { m_text.reserve(FORMAT_BUFFER_RESERVE); };
+
+  void clear() noexcept { m_text.clear(); };
+  [[nodiscard]] const char* c_str() const noexcept { return m_text.c_str(); };
+  [[nodiscard]] std::string_view view() const noexcept { return m_text; };
+
+  /**
+   * @brief   Appends a string.
+   *
+   * @param   str The string to append
+   * @return      Reference to the buffer
+   */
+  FormatBuffer& append(std::string_view str) {
+    m_text.append(str.data(), str.size());
+    return *this;
+  };
+
+  /**
+   * @brief   Appends the text representation of a value.
+   *
+   * @tparam  T     The value type
+   * @param   value The value to append
+   * @return        Reference to the buffer
+   *
+   * @details Matches operator<<: characters print as characters, bools as
+   *          0/1 and enums as their underlying value. Floating-point values
+   *          print in their shortest round-trip form.
+   */
+  template <typename T>
+  FormatBuffer& append_value(const T& value) {
+    if constexpr (std::is_enum_v<T>) {
+      return append_value(static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_same_v<T, char> ||
+                         std::is_same_v<T, signed char> ||
+                         std::is_same_v<T, unsigned char>) {
+      m_text.push_back(static_cast<char>(value));
+    } else if constexpr (std::is_same_v<T, bool>) {
+      m_text.push_back(value ? '1' : '0');
+    } else if constexpr (std::is_integral_v<T>) {
+      std::array<char, FORMAT_NUMBER_LEN> number_;
+      const auto end_{
+          std::to_chars(number_.data(), number_.data() + number_.size(), value)
+              .ptr};
+      m_text.append(number_.data(), end_);
+    } else if constexpr (std::is_floating_point_v<T>) {
+      std::array<char, FORMAT_NUMBER_LEN> number_;
+      m_text.append(number_.data(), format_float(value, number_.data(),
+                                                 number_.data() +
+                                                     number_.size()));
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+      append(std::string_view{value});
+    } else {
+      // A value whose operator<< logs gets its own stream
+      thread_local std::ostringstream oss_;
+      thread_local bool busy_{false};
+      if (busy_) {
+        std::ostringstream nested_;
+        nested_ << value;
+        return append(nested_.str());
+      }
+      busy_ = true;
+      oss_.str(std::string{});
+      oss_.clear();
+      try {
+        oss_ << value;
+      } catch (...) {
+        busy_ = false;
+        throw;
+      }
+      busy_ = false;
+      append(oss_.str());
+    }
+    return *this;
+  };
+};
+
+/**
+ * @brief   Thread-local buffers shared by the debug macros.
+ *
+ * @details A log line formats its arguments into ARGS and the FUNC result
+ *          into VALUE, so both can be passed to the same ROS_DEBUG call.
+ */
+enum class FormatSlot { ARGS = 0, VALUE, COUNT };
+
+/**
+ * @brief   Reservation of a format buffer for one log line.
+ *
+ * @details Returned by format_buffer(). The buffer stays reserved until the
+ *          lease is destroyed, normally at the end of the full expression,
+ *          so a line formatted while another one is being built (e.g. by an
+ *          operator<< that logs) gets the next buffer of the slot instead of
+ *          clearing the outer line. Leases are released in reverse order of
+ *          acquisition, as temporaries are.
+ */
+class FormatLease {
+ private:
+  FormatBuffer* m_buffer;
+  std::size_t* m_depth;
+  std::unique_ptr<FormatBuffer> m_owned{};
+
+ public:
+  /**
+   * @brief   Reserves a buffer of a slot stack.
+   *
+   * @param   buffer The buffer
+   * @param   depth  The depth counter of the stack, already incremented
+   */
+  FormatLease(FormatBuffer& buffer, std::size_t& depth) noexcept
+      : m_buffer{&buffer}, m_depth{&depth} {};
+
+  /**
+   * @brief   Owns a buffer, used when the slot stack is exhausted.
+   *
+   * @param   owned The buffer
+   */
+  explicit FormatLease(std::unique_ptr<FormatBuffer> owned) noexcept
+      : m_buffer{owned.get()}, m_depth{nullptr}, m_owned{std::move(owned)} {};
+
+  FormatLease(FormatLease&& other) noexcept
+      : m_buffer{other.m_buffer},
+        m_depth{std::exchange(other.m_depth, nullptr)},
+        m_owned{std::move(other.m_owned)} {};
+  FormatLease(const FormatLease&) = delete;
+  FormatLease& operator=(const FormatLease&) = delete;
+  FormatLease& operator=(FormatLease&&) = delete;
+
+  ~FormatLease() {
+    if (m_depth) --*m_depth;
+  };
+
+  [[nodiscard]] FormatBuffer& operator*() const noexcept { return *m_buffer; };
+  FormatBuffer* operator->() const noexcept { return m_buffer; };
+  operator FormatBuffer&() const noexcept { return *m_buffer; };
+
+  [[nodiscard]] const char* c_str() const noexcept {
+    return m_buffer->c_str();
+  };
+  [[nodiscard]] std::string_view view() const noexcept {
+    return m_buffer->view();
+  };
+};
+
+/**
+ * @brief   Reserves a cleared thread-local format buffer.
+ *
+ * @param   slot The buffer slot
+ * @return       Lease on the calling thread's buffer
+ *
+ * @details Each slot keeps FORMAT_BUFFER_DEPTH buffers per thread, one per
+ *          level of nested log lines. Deeper lines fall back to a buffer
+ *          owned by the lease, which allocates.
+ */
+inline FormatLease format_buffer(FormatSlot slot) {
+  struct Stack {
+    std::array<FormatBuffer, FORMAT_BUFFER_DEPTH> buffers{};
+    std::size_t depth{0};
+  };
+  thread_local std::array<Stack, static_cast<std::size_t>(FormatSlot::COUNT)>
+      stacks_{};
+  auto& stack_{stacks_[static_cast<std::size_t>(slot)]};
+  if (stack_.depth == FORMAT_BUFFER_DEPTH)
+    return FormatLease{std::make_unique<FormatBuffer>()};
+  auto& buffer_{stack_.buffers[stack_.depth++]};
+  buffer_.clear();
+  return FormatLease{buffer_, stack_.depth};
+};
+
+/**
+ * @brief   Formats a colored value into a VALUE buffer.
+ *
+ * @tparam  T     The value type
+ * @param   color ANSI color code
+ * @param   value The value
+ * @return        Lease on the buffer; its c_str() is valid while the lease
+ *                lives, i.e. until the end of the full expression
+ */
+template <typename T>
+FormatLease paint(std::string_view color, const T& value) {
+  auto lease_{format_buffer(FormatSlot::VALUE)};
+  lease_->append(color).append_value(value);
+  return lease_;
+};
+}  // namespace r2d2_format
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_FORMAT_HPP_
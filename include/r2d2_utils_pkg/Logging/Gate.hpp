@@ -0,0 +1,81 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_GATE_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_GATE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief   Runs a statement at most once per period at this call site.
+ *
+ * @param   period    Minimum time between two runs, in seconds
+ * @param   statement The statement to run (not evaluated when suppressed)
+ *
+ * @details The call-site state is one function-local static atomic holding
+ *          the time of the last run.
+ */
+#define DEBUG_THROTTLE(period, statement)                                    \
+  do {                                                                       \
+    static std::atomic<std::int64_t> throttleNs_{r2d2_gate::THROTTLE_NEVER}; \
+    if (r2d2_gate::throttle(throttleNs_, period)) statement;                 \
+  } while (false)
+
+/**
+ * @brief   Runs a statement on the first and then every n-th call at this
+ *          call site.
+ *
+ * @param   n         The sampling interval in calls
+ * @param   statement The statement to run (not evaluated when suppressed)
+ *
+ * @details The call-site state is one function-local static atomic counting
+ *          the calls.
+ */
+#define DEBUG_SAMPLE(n, statement)                     \
+  do {                                                 \
+    static std::atomic<std::uint64_t> sampleCount_{0}; \
+    if (r2d2_gate::sample(sampleCount_, n)) statement; \
+  } while (false)
+
+namespace r2d2_gate {
+constexpr std::int64_t THROTTLE_NEVER{std::numeric_limits<std::int64_t>::min()};
+
+/**
+ * @brief   Decides whether a throttled call site may run now.
+ *
+ * @param   lastNs The call-site state (steady-clock time of the last run)
+ * @param   period Minimum time between two runs, in seconds
+ * @return         True if the period has elapsed and this caller claimed it
+ *
+ * @details Only one of several racing threads wins a given period. Uses the
+ *          steady clock, so throttling is unaffected by simulated time.
+ */
+inline bool throttle(std::atomic<std::int64_t>& lastNs,
+                     double period) noexcept {
+  const std::int64_t now_{
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count()};
+  std::int64_t last_{lastNs.load(std::memory_order_relaxed)};
+  if (last_ != THROTTLE_NEVER &&
+      static_cast<double>(now_ - last_) < period * 1e9)
+    return false;
+  return lastNs.compare_exchange_strong(last_, now_,
+                                        std::memory_order_relaxed);
+};
+
+/**
+ * @brief   Decides whether a sampled call site may run now.
+ *
+ * @param   count The call-site state (number of calls so far)
+ * @param   n     The sampling interval in calls (0 and 1 run every call)
+ * @return        True on the first and every n-th call
+ */
+inline bool sample(std::atomic<std::uint64_t>& count,
+                   std::uint64_t n) noexcept {
+  const std::uint64_t count_{count.fetch_add(1, std::memory_order_relaxed)};
+  return n <= 1 || count_ % n == 0;
+};
+}  // namespace r2d2_gate
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_GATE_HPP_
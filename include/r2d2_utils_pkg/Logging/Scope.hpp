@@ -0,0 +1,383 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_SCOPE_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_SCOPE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(R2D2_SCOPE_TSC) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define R2D2_SCOPE_USE_TSC 1
+#endif
+
+#include "Color.hpp"
+
+#define SCOPE_CONCAT_IMPL(a, b) a##b
+#define SCOPE_CONCAT(a, b) SCOPE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief   Times the enclosing scope into the per-call-site histogram.
+ *
+ * @details The call site and the calling thread's histogram shard are
+ *          function-local statics; at runtime the macro costs two clock reads
+ *          and a few relaxed atomic operations.
+ */
+#define DEBUG_SCOPE_TIMER(name)                                        \
+  static r2d2_latency::ScopeSite SCOPE_CONCAT(scopeSite_, __LINE__){   \
+      name, __func__};                                                 \
+  thread_local r2d2_latency::Histogram& SCOPE_CONCAT(scopeShard_,      \
+                                                     __LINE__){        \
+      SCOPE_CONCAT(scopeSite_, __LINE__).shard()};                     \
+  const r2d2_latency::ScopeTimer SCOPE_CONCAT(scopeTimer_, __LINE__) { \
+    SCOPE_CONCAT(scopeShard_, __LINE__)                                \
+  }
+
+namespace r2d2_latency {
+constexpr std::size_t HISTOGRAM_SUB_BITS{3};
+constexpr std::size_t HISTOGRAM_SUB_COUNT{1 << HISTOGRAM_SUB_BITS};
+constexpr std::size_t HISTOGRAM_BUCKETS{64 * HISTOGRAM_SUB_COUNT};
+
+/**
+ * @brief   Reads the timing clock.
+ *
+ * @return  TSC ticks if R2D2_SCOPE_TSC is defined on x86, steady-clock
+ *          nanoseconds otherwise
+ */
+inline std::uint64_t ticks() noexcept {
+#ifdef R2D2_SCOPE_USE_TSC
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+};
+
+/**
+ * @brief   Gets the log-linear bucket of a value.
+ *
+ * @param   value The sample
+ * @return        The bucket index
+ *
+ * @details Values below HISTOGRAM_SUB_COUNT get exact buckets; above that,
+ *          every power of two is split into HISTOGRAM_SUB_COUNT linear
+ *          buckets, bounding the relative error to 1 / HISTOGRAM_SUB_COUNT.
+ */
+constexpr std::size_t bucket_of(std::uint64_t value) noexcept {
+  if (value < HISTOGRAM_SUB_COUNT) return static_cast<std::size_t>(value);
+  std::size_t msb_{0};
+  while ((value >> msb_) > 1) ++msb_;
+  const std::size_t shift_{msb_ - HISTOGRAM_SUB_BITS};
+  return (shift_ + 1) * HISTOGRAM_SUB_COUNT +
+         static_cast<std::size_t>((value >> shift_) &
+                                  (HISTOGRAM_SUB_COUNT - 1));
+};
+
+/**
+ * @brief   Gets the largest value that falls into a bucket.
+ *
+ * @param   bucket The bucket index
+ * @return         The inclusive upper bound of the bucket
+ */
+constexpr std::uint64_t bucket_max(std::size_t bucket) noexcept {
+  if (bucket < HISTOGRAM_SUB_COUNT) return bucket;
+  const std::size_t shift_{bucket / HISTOGRAM_SUB_COUNT - 1};
+  const std::uint64_t low_{(HISTOGRAM_SUB_COUNT + bucket % HISTOGRAM_SUB_COUNT)
+                           << shift_};
+  return low_ + ((std::uint64_t{1} << shift_) - 1);
+};
+
+/**
+ * @brief   Log-linear (HDR-style) histogram written by a single thread.
+ *
+ * @details Counters are atomics updated with relaxed load/store pairs, so the
+ *          owning thread never executes a read-modify-write and any thread
+ *          may read a consistent-enough snapshot concurrently.
+ */
+class Histogram {
+ private:
+  std::array<std::atomic<std::uint64_t>, HISTOGRAM_BUCKETS> m_counts{};
+
+ public:
+  /**
+   * @brief   Adds a sample. Must only be called by the owning thread.
+   *
+   * @param   value The sample in clock ticks
+   */
+  void record(std::uint64_t value) noexcept {
+    auto& count_{m_counts[bucket_of(value)]};
+    count_.store(count_.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+  };
+
+  /**
+   * @brief   Adds the current counts to an accumulator.
+   *
+   * @param   acc The accumulator
+   */
+  void merge_into(std::array<std::uint64_t, HISTOGRAM_BUCKETS>& acc) const {
+    for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i)
+      acc[i] += m_counts[i].load(std::memory_order_relaxed);
+  };
+};
+
+/**
+ * @brief   Summary statistics of a histogram, in nanoseconds.
+ */
+struct LatencyStats {
+  std::uint64_t count{};
+  double p50{};
+  double p99{};
+  double max{};
+};
+
+/**
+ * @brief   Computes count and percentiles of a bucket array.
+ *
+ * @param   counts  The bucket counts
+ * @param   toNanos Conversion factor from clock ticks to nanoseconds
+ * @return          The statistics (bucket upper bounds)
+ */
+inline LatencyStats stats_of(
+    const std::array<std::uint64_t, HISTOGRAM_BUCKETS>& counts,
+    double toNanos) {
+  LatencyStats stats_{};
+  for (const auto count_ : counts) stats_.count += count_;
+  if (stats_.count == 0) return stats_;
+
+  const std::uint64_t p50_{(stats_.count + 1) / 2};
+  const std::uint64_t p99_{
+      std::max<std::uint64_t>(1, (stats_.count * 99 + 99) / 100)};
+  std::uint64_t seen_{0};
+  for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+    if (counts[i] == 0) continue;
+    const bool below50_{seen_ < p50_}, below99_{seen_ < p99_};
+    seen_ += counts[i];
+    const double value_{static_cast<double>(bucket_max(i)) * toNanos};
+    if (below50_ && seen_ >= p50_) stats_.p50 = value_;
+    if (below99_ && seen_ >= p99_) stats_.p99 = value_;
+    stats_.max = value_;
+  }
+  return stats_;
+};
+
+class ScopeSite;
+
+/**
+ * @brief   Process-wide list of scope call sites.
+ */
+class ScopeRegistry {
+ private:
+  std::mutex m_mutex{};
+  std::vector<ScopeSite*> m_sites{};
+  const std::uint64_t m_ticks0{ticks()};
+  const std::chrono::steady_clock::time_point m_time0{
+      std::chrono::steady_clock::now()};
+  std::atomic<std::int64_t> m_lastReportNs{0};
+
+ public:
+  void add(ScopeSite* site) {
+    std::lock_guard lock_{m_mutex};
+    m_sites.push_back(site);
+  };
+  void remove(ScopeSite* site) {
+    std::lock_guard lock_{m_mutex};
+    m_sites.erase(std::remove(m_sites.begin(), m_sites.end(), site),
+                  m_sites.end());
+  };
+
+  /**
+   * @brief   Gets the conversion factor from clock ticks to nanoseconds.
+   *
+   * @return  1 for steady-clock ticks, the TSC calibration otherwise
+   *
+   * @details The TSC is calibrated against the steady clock over the time
+   *          since the registry was created.
+   */
+  double to_nanos() const {
+#ifdef R2D2_SCOPE_USE_TSC
+    const auto ns_{std::chrono::duration<double, std::nano>(
+                       std::chrono::steady_clock::now() - m_time0)
+                       .count()};
+    const auto ticks_{static_cast<double>(ticks() - m_ticks0)};
+    return ticks_ > 0 ? ns_ / ticks_ : 1.0;
+#else
+    return 1.0;
+#endif
+  };
+
+  template <typename Func>
+  void for_each(Func&& func) {
+    std::lock_guard lock_{m_mutex};
+    for (auto* site_ : m_sites) func(*site_);
+  };
+
+  /**
+   * @brief   Claims the next periodic report slot.
+   *
+   * @param   periodNs The report period in nanoseconds
+   * @return           True if a report is due and this caller should make it
+   */
+  bool due(std::int64_t periodNs) noexcept {
+    const auto now_{std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - m_time0)
+                        .count()};
+    auto last_{m_lastReportNs.load(std::memory_order_relaxed)};
+    return now_ - last_ >= periodNs &&
+           m_lastReportNs.compare_exchange_strong(last_, now_,
+                                                  std::memory_order_relaxed);
+  };
+};
+
+/**
+ * @brief   Gets the process-wide scope registry.
+ *
+ * @return  Reference to the registry
+ */
+inline ScopeRegistry& registry() {
+  static ScopeRegistry registry_{};
+  return registry_;
+};
+
+/**
+ * @brief   Static description of a timed scope with one histogram shard per
+ *          thread.
+ */
+class ScopeSite {
+ private:
+  const char* m_name;
+  const char* m_func;
+  std::mutex m_mutex{};
+  std::vector<std::unique_ptr<Histogram>> m_shards{};
+  std::array<std::uint64_t, HISTOGRAM_BUCKETS> m_reported{};
+
+ public:
+  /**
+   * @brief   Constructs and registers a ScopeSite.
+   *
+   * @param   name The scope name (must outlive the site, e.g. a literal)
+   * @param   func The enclosing function name
+   */
+  ScopeSite(const char* name, const char* func) : m_name{name}, m_func{func} {
+    registry().add(this);
+  };
+  ScopeSite(const ScopeSite&) = delete;
+  ScopeSite& operator=(const ScopeSite&) = delete;
+  ~ScopeSite() { registry().remove(this); };
+
+  /**
+   * @brief   Creates a histogram shard for the calling thread.
+   *
+   * @return  Reference to the new shard, owned by the site
+   */
+  Histogram& shard() {
+    std::lock_guard lock_{m_mutex};
+    return *m_shards.emplace_back(std::make_unique<Histogram>());
+  };
+
+  [[nodiscard]] const char* name() const noexcept { return m_name; };
+  [[nodiscard]] const char* func() const noexcept { return m_func; };
+
+  /**
+   * @brief   Gets statistics over every shard.
+   *
+   * @param   toNanos Conversion factor from clock ticks to nanoseconds
+   * @param   delta   If true, only samples since the previous delta call
+   * @return          The statistics
+   *
+   * @details The delta baseline is read and updated under the site mutex,
+   *          so concurrent reports each get a consistent window.
+   */
+  LatencyStats stats(double toNanos, bool delta) {
+    std::array<std::uint64_t, HISTOGRAM_BUCKETS> counts_{};
+    std::unique_lock lock_{m_mutex};
+    for (const auto& shard_ : m_shards) shard_->merge_into(counts_);
+    if (!delta) {
+      lock_.unlock();
+      return stats_of(counts_, toNanos);
+    }
+    auto window_{counts_};
+    for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i)
+      window_[i] -= m_reported[i];
+    m_reported = counts_;
+    lock_.unlock();
+    return stats_of(window_, toNanos);
+  };
+};
+
+/**
+ * @brief   RAII timer that records its lifetime into a histogram shard.
+ */
+class ScopeTimer {
+ private:
+  Histogram& m_shard;
+  std::uint64_t m_start{ticks()};
+
+ public:
+  explicit ScopeTimer(Histogram& shard) noexcept : m_shard{shard} {};
+  ScopeTimer(const ScopeTimer&) = delete;
+  ScopeTimer& operator=(const ScopeTimer&) = delete;
+  ~ScopeTimer() { m_shard.record(ticks() - m_start); };
+};
+
+/**
+ * @brief   Formats one report line per timed scope.
+ *
+ * @tparam  Sink  Callable taking a const std::string&
+ * @param   sink  The line sink
+ * @param   delta If true, report only samples since the previous report
+ *
+ * @details Scopes without samples are skipped. Colors come from the
+ *          ColorPreset::RESULT preset.
+ */
+template <typename Sink>
+void report(Sink&& sink, bool delta = true) {
+  using r2d2_console::ColorPreset;
+  constexpr auto color_{r2d2_console::paint(ColorPreset::RESULT)};
+  const double toNanos_{registry().to_nanos()};
+  registry().for_each([&](ScopeSite& site) {
+    const auto stats_{site.stats(toNanos_, delta)};
+    if (stats_.count == 0) return;
+    std::ostringstream oss_;
+    oss_ << color_.name << site.name() << ANSI_RESET << " in "
+         << color_.function << site.func() << ANSI_RESET << ": ";
+    auto field_ = [&](const char* label, double ns, const char* sep) {
+      oss_ << color_.arg.name << label << " = " << color_.arg.value
+           << ns / 1e3 << " us" << ANSI_RESET << sep;
+    };
+    oss_ << color_.arg.name << "n = " << color_.arg.value << stats_.count
+         << ANSI_RESET << ", ";
+    field_("p50", stats_.p50, ", ");
+    field_("p99", stats_.p99, ", ");
+    field_("max", stats_.max, "");
+    sink(oss_.str());
+  });
+};
+
+/**
+ * @brief   Reports every timed scope if the period has elapsed since the last
+ *          periodic report.
+ *
+ * @tparam  Sink   Callable taking a const std::string&
+ * @param   period The report period
+ * @param   sink   The line sink
+ * @return         True if a report was made
+ */
+template <typename Sink>
+bool report_every(std::chrono::nanoseconds period, Sink&& sink) {
+  if (!registry().due(period.count())) return false;
+  report(std::forward<Sink>(sink));
+  return true;
+};
+}  // namespace r2d2_latency
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_SCOPE_HPP_
@@ -0,0 +1,578 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_TRACE_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_TRACE_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Async.hpp"
+#include "Format.hpp"
+
+namespace r2d2_trace {
+constexpr std::array<char, 8> TRACE_MAGIC{'R', '2', 'D', '2',
+                                          'T', 'R', 'C', '1'};
+constexpr std::uint32_t TRACE_VERSION{1};
+constexpr std::size_t TRACE_SEGMENT_LEN{std::size_t{64} << 20};
+constexpr std::size_t TRACE_SEGMENT_COUNT{8};
+constexpr std::size_t TRACE_ALIGN{8};
+constexpr std::string_view TRACE_EXTENSION{".r2d2trace"};
+
+/**
+ * @brief   Kind of an entry in a trace segment.
+ */
+enum class EntryTag : std::uint16_t { END = 0, SITE, EVENT, DROP };
+
+/**
+ * @brief   Header at the start of every trace segment.
+ *
+ * @details All fields are in host byte order; byteOrder reads 0x01020304 on
+ *          a host with the same endianness as the writer.
+ */
+struct SegmentHeader {
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+  std::uint64_t sequence;
+  std::int64_t startNs;
+};
+static_assert(sizeof(SegmentHeader) == 32, "Unexpected SegmentHeader layout!");
+
+/**
+ * @brief   Fixed-layout header of every entry.
+ *
+ * @details The payload follows the header and is padded to TRACE_ALIGN. The
+ *          tag is written last, so an entry interrupted by a crash reads as
+ *          the end of the segment.
+ */
+struct EntryHeader {
+  EntryTag tag;
+  std::uint16_t len;
+  std::uint32_t siteId;
+  std::uint32_t thread;
+  std::uint32_t reserved;
+  std::int64_t timeNs;
+};
+static_assert(sizeof(EntryHeader) == 24, "Unexpected EntryHeader layout!");
+
+/**
+ * @brief   Rounds a length up to the entry alignment.
+ *
+ * @param   len The length
+ * @return      The aligned length
+ */
+constexpr std::size_t aligned(std::size_t len) noexcept {
+  return (len + TRACE_ALIGN - 1) & ~(TRACE_ALIGN - 1);
+};
+
+/**
+ * @brief   Gets the file name of a trace segment.
+ *
+ * @param   base     The path prefix of the trace
+ * @param   sequence The segment number
+ * @return           "<base>.<sequence>.r2d2trace"
+ */
+inline std::string segment_path(std::string_view base,
+                                std::uint64_t sequence) {
+  std::string path_{base};
+  path_.append(".").append(std::to_string(sequence)).append(TRACE_EXTENSION);
+  return path_;
+};
+
+/**
+ * @brief   Record sink that appends binary entries to memory-mapped trace
+ *          segments.
+ *
+ * @details Each segment is a preallocated file of a fixed size mapped into
+ *          memory, so writing an entry is a memcpy. When a segment is full,
+ *          it is truncated to its used length and the next one is opened;
+ *          only the newest segmentCount segments are kept. Call sites are
+ *          described by SITE entries the first time they appear in each
+ *          segment, so every segment decodes on its own. Entries that cannot
+ *          be written (e.g. the next segment cannot be created) are counted
+ *          by lost().
+ */
+class TraceSink final : public r2d2_async::IRecordSink {
+ private:
+  std::string m_base;
+  std::size_t m_segmentLen;
+  std::size_t m_segmentCount;
+  int m_fd{-1};
+  std::byte* m_map{nullptr};
+  std::size_t m_pos{0};
+  std::uint64_t m_sequence{0};
+  struct SiteEntry {
+    std::uint32_t id;
+    std::string names;
+    bool written;
+  };
+  std::unordered_map<const r2d2_async::CallSite*, SiteEntry> m_sites{};
+  std::uint64_t m_lost{0};
+
+ public:
+  /**
+   * @brief   Constructs a TraceSink and opens its first segment.
+   *
+   * @param   base         The path prefix of the segment files
+   * @param   segmentLen   The size of every segment in bytes
+   * @param   segmentCount The number of segments kept on disk
+   * @throws  std::system_error if the first segment cannot be created
+   */
+  explicit TraceSink(std::string base,
+                     std::size_t segmentLen = TRACE_SEGMENT_LEN,
+                     std::size_t segmentCount = TRACE_SEGMENT_COUNT)
+      : m_base{std::move(base)},
+        m_segmentLen{std::max(segmentLen, std::size_t{4096})},
+        m_segmentCount{std::max(segmentCount, std::size_t{1})} {
+    if (!open_segment())
+      throw std::system_error{errno, std::generic_category(),
+                              segment_path(m_base, m_sequence)};
+  };
+
+  TraceSink(const TraceSink&) = delete;
+  TraceSink& operator=(const TraceSink&) = delete;
+
+  ~TraceSink() { close_segment(); };
+
+  void write(const r2d2_async::Record& record, std::uint32_t thread) override {
+    SiteEntry& site_{site_of(record.site)};
+    const std::size_t len_{event_len(record)};
+    const std::size_t siteLen_{site_len(*record.site, *record.format,
+                                        site_.names)};
+    // Reserve room for the SITE entry too, as a rotation forgets every site
+    if (!reserve(2 * sizeof(EntryHeader) + aligned(siteLen_) + aligned(len_)))
+      return;
+    if (!site_.written) {
+      write_site(site_, *record.site, *record.format, siteLen_);
+      site_.written = true;
+    }
+    std::byte* payload_{begin_entry(len_)};
+    payload_[0] = static_cast<std::byte>(record.labelLen);
+    std::memcpy(payload_ + 1, record.payload.data(), len_ - 1);
+    end_entry(EntryTag::EVENT, len_, site_.id, thread, record.timeNs);
+  };
+
+  void dropped(std::uint64_t count, std::uint32_t thread) override {
+    if (!reserve(sizeof(EntryHeader) + sizeof(count))) return;
+    std::memcpy(begin_entry(sizeof(count)), &count, sizeof(count));
+    end_entry(EntryTag::DROP, sizeof(count), 0, thread, now_ns());
+  };
+
+  void flush() override {
+    if (m_map) ::msync(m_map, m_segmentLen, MS_ASYNC);
+  };
+
+  /**
+   * @brief   Gets the number of entries that could not be written.
+   *
+   * @return  The number of lost entries
+   */
+  [[nodiscard]] std::uint64_t lost() const noexcept { return m_lost; };
+
+ private:
+  static std::int64_t now_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  };
+
+  static std::size_t event_len(const r2d2_async::Record& record) noexcept {
+    return 1 + record.labelLen + record.format->argsLen;
+  };
+
+  static std::string names_of(const r2d2_async::CallSite& site) {
+    std::string names_{};
+    for (std::size_t i = 0; i < site.names.size(); ++i) {
+      if (i > 0) names_.append(", ");
+      names_.append(site.names[i]);
+    }
+    return names_;
+  };
+
+  static std::size_t site_len(const r2d2_async::CallSite& site,
+                              const r2d2_async::RecordFormat& format,
+                              std::string_view names) {
+    return 2 + sizeof(std::uint16_t) + format.count +
+           3 * sizeof(std::uint16_t) + std::strlen(site.func) +
+           std::strlen(site.color) + names.size();
+  };
+
+  SiteEntry& site_of(const r2d2_async::CallSite* site) {
+    const auto it_{m_sites.find(site)};
+    if (it_ != m_sites.end()) return it_->second;
+    return m_sites
+        .emplace(site, SiteEntry{static_cast<std::uint32_t>(m_sites.size()),
+                                 names_of(*site), false})
+        .first->second;
+  };
+
+  bool reserve(std::size_t len) {
+    if (m_map && m_pos + len + sizeof(EntryHeader) <= m_segmentLen) return true;
+    close_segment();
+    ++m_sequence;
+    if (!open_segment() || m_pos + len + sizeof(EntryHeader) > m_segmentLen) {
+      ++m_lost;
+      return false;
+    }
+    return true;
+  };
+
+  std::byte* begin_entry(std::size_t len) noexcept {
+    std::memset(m_map + m_pos + sizeof(EntryHeader) + len, 0,
+                aligned(len) - len);
+    return m_map + m_pos + sizeof(EntryHeader);
+  };
+
+  void end_entry(EntryTag tag, std::size_t len, std::uint32_t siteId,
+                 std::uint32_t thread, std::int64_t timeNs) noexcept {
+    EntryHeader header_{EntryTag::END, static_cast<std::uint16_t>(len),
+                        siteId,        thread,
+                        0,             timeNs};
+    std::memcpy(m_map + m_pos, &header_, sizeof(header_));
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(m_map + m_pos, &tag, sizeof(tag));
+    m_pos += sizeof(EntryHeader) + aligned(len);
+  };
+
+  void write_site(const SiteEntry& entry, const r2d2_async::CallSite& site,
+                  const r2d2_async::RecordFormat& format, std::size_t len) {
+    std::byte* payload_{begin_entry(len)};
+    std::size_t pos_{0};
+    auto put_ = [&](const void* src, std::size_t n) {
+      std::memcpy(payload_ + pos_, src, n);
+      pos_ += n;
+    };
+    auto put_str_ = [&](std::string_view str) {
+      const auto n_{static_cast<std::uint16_t>(str.size())};
+      put_(&n_, sizeof(n_));
+      put_(str.data(), n_);
+    };
+    put_(&site.kind, 1);
+    put_(&format.count, 1);
+    put_(&format.argsLen, sizeof(format.argsLen));
+    put_(format.types.data(), format.count);
+    put_str_(site.func);
+    put_str_(site.color);
+    put_str_(entry.names);
+    end_entry(EntryTag::SITE, len, entry.id, 0, 0);
+  };
+
+  bool open_segment() {
+    const std::string path_{segment_path(m_base, m_sequence)};
+    m_fd = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_fd < 0) return false;
+    const auto len_{static_cast<off_t>(m_segmentLen)};
+    if (::posix_fallocate(m_fd, 0, len_) != 0 && ::ftruncate(m_fd, len_) != 0) {
+      close_segment();
+      return false;
+    }
+    void* map_{::mmap(nullptr, m_segmentLen, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, m_fd, 0)};
+    if (map_ == MAP_FAILED) {
+      close_segment();
+      return false;
+    }
+    m_map = static_cast<std::byte*>(map_);
+    const SegmentHeader header_{TRACE_MAGIC, TRACE_VERSION, 0x01020304,
+                                m_sequence, now_ns()};
+    std::memcpy(m_map, &header_, sizeof(header_));
+    m_pos = sizeof(header_);
+    for (auto& [site_, entry_] : m_sites) entry_.written = false;
+    if (m_sequence >= m_segmentCount)
+      ::unlink(segment_path(m_base, m_sequence - m_segmentCount).c_str());
+    return true;
+  };
+
+  void close_segment() noexcept {
+    if (m_map) {
+      ::msync(m_map, m_segmentLen, MS_SYNC);
+      ::munmap(m_map, m_segmentLen);
+      m_map = nullptr;
+      // On failure the zeroed tail is kept, which still reads as END
+      [[maybe_unused]] const int truncated_{
+          ::ftruncate(m_fd, static_cast<off_t>(m_pos))};
+    }
+    if (m_fd >= 0) ::close(m_fd);
+    m_fd = -1;
+    m_pos = 0;
+  };
+};
+
+/**
+ * @brief   Call site as described by a SITE entry.
+ */
+struct TraceSite {
+  r2d2_async::SiteKind kind{};
+  std::vector<r2d2_async::TypeCode> types{};
+  std::uint16_t argsLen{};
+  std::string func{};
+  std::string color{};
+  std::string names{};
+};
+
+/**
+ * @brief   Event as read from an EVENT or DROP entry.
+ *
+ * @details label and args point into the reader's segment data; site is
+ *          nullptr for DROP events.
+ */
+struct TraceEvent {
+  EntryTag tag{};
+  const TraceSite* site{nullptr};
+  std::uint32_t thread{};
+  std::int64_t timeNs{};
+  std::string_view label{};
+  const std::byte* args{nullptr};
+  std::uint64_t dropped{};
+};
+
+/**
+ * @brief   Calls a function with a raw argument decoded to its type.
+ *
+ * @tparam  Func Callable taking any arithmetic value
+ * @param   type The type code
+ * @param   src  The raw bytes
+ * @param   func The callback
+ * @return       The size of the decoded value, 0 for an unknown type code
+ */
+template <typename Func>
+std::size_t visit_value(r2d2_async::TypeCode type, const std::byte* src,
+                        Func&& func) {
+  using r2d2_async::TypeCode;
+  auto as_ = [&](auto value) {
+    std::memcpy(&value, src, sizeof(value));
+    func(value);
+    return sizeof(value);
+  };
+  switch (type) {
+    case TypeCode::BOOL: return as_(bool{});
+    case TypeCode::CHAR: return as_(char{});
+    case TypeCode::I8: return as_(std::int8_t{});
+    case TypeCode::U8: return as_(std::uint8_t{});
+    case TypeCode::I16: return as_(std::int16_t{});
+    case TypeCode::U16: return as_(std::uint16_t{});
+    case TypeCode::I32: return as_(std::int32_t{});
+    case TypeCode::U32: return as_(std::uint32_t{});
+    case TypeCode::I64: return as_(std::int64_t{});
+    case TypeCode::U64: return as_(std::uint64_t{});
+    case TypeCode::F32: return as_(float{});
+    case TypeCode::F64: return as_(double{});
+    case TypeCode::F80: return as_(static_cast<long double>(0));
+    default: return 0;
+  }
+};
+
+/**
+ * @brief   Reader of the trace segments written by TraceSink.
+ *
+ * @details Segments are visited in sequence order, and call sites described
+ *          in a segment stay known in the following ones, so any contiguous
+ *          range of segments decodes. Every field is checked against the
+ *          length of its entry; entries that do not fit are skipped, so a
+ *          corrupt segment cannot make the reader or format_event() read
+ *          past the data.
+ */
+class TraceReader {
+ private:
+  struct Segment {
+    SegmentHeader header;
+    std::vector<std::byte> data;
+  };
+  std::vector<Segment> m_segments{};
+  std::unordered_map<std::uint32_t, TraceSite> m_sites{};
+
+ public:
+  /**
+   * @brief   Loads a segment file.
+   *
+   * @param   path The segment path
+   * @throws  std::runtime_error if the file cannot be read or is not a
+   *          trace segment of this version and byte order
+   */
+  void load(const std::string& path) {
+    std::ifstream file_{path, std::ios::binary};
+    if (!file_) throw std::runtime_error{"Cannot open \"" + path + "\"!"};
+    const std::vector<char> raw_{std::istreambuf_iterator<char>{file_}, {}};
+    Segment segment_{};
+    if (raw_.size() >= sizeof(SegmentHeader))
+      std::memcpy(&segment_.header, raw_.data(), sizeof(SegmentHeader));
+    if (raw_.size() < sizeof(SegmentHeader) ||
+        segment_.header.magic != TRACE_MAGIC ||
+        segment_.header.version != TRACE_VERSION ||
+        segment_.header.byteOrder != 0x01020304)
+      throw std::runtime_error{"\"" + path + "\" is not a trace segment!"};
+    segment_.data.resize(raw_.size());
+    std::memcpy(segment_.data.data(), raw_.data(), raw_.size());
+    const auto pos_{std::upper_bound(
+        m_segments.begin(), m_segments.end(), segment_.header.sequence,
+        [](std::uint64_t sequence, const Segment& segment) {
+          return sequence < segment.header.sequence;
+        })};
+    m_segments.insert(pos_, std::move(segment_));
+  };
+
+  [[nodiscard]] bool empty() const noexcept { return m_segments.empty(); };
+
+  /**
+   * @brief   Visits every event of the loaded segments in write order.
+   *
+   * @tparam  Func Callable taking a const TraceEvent&
+   * @param   func The callback
+   *
+   * @details Events of call sites that were never described, and entries
+   *          whose fields overrun their length, are skipped.
+   */
+  template <typename Func>
+  void for_each(Func&& func) {
+    for (const auto& segment_ : m_segments) {
+      const auto& data_{segment_.data};
+      std::size_t pos_{sizeof(SegmentHeader)};
+      while (pos_ + sizeof(EntryHeader) <= data_.size()) {
+        EntryHeader header_{};
+        std::memcpy(&header_, data_.data() + pos_, sizeof(header_));
+        const std::byte* payload_{data_.data() + pos_ + sizeof(header_)};
+        if (header_.tag == EntryTag::END ||
+            pos_ + sizeof(header_) + header_.len > data_.size())
+          break;
+        pos_ += sizeof(header_) + aligned(header_.len);
+        TraceEvent event_{header_.tag, nullptr, header_.thread,
+                          header_.timeNs};
+        if (header_.tag == EntryTag::SITE) {
+          if (auto site_ = parse_site(payload_, header_.len))
+            m_sites[header_.siteId] = std::move(*site_);
+        } else if (header_.tag == EntryTag::EVENT) {
+          const auto it_{m_sites.find(header_.siteId)};
+          if (it_ == m_sites.end() || header_.len < 1) continue;
+          const auto labelLen_{static_cast<std::size_t>(payload_[0])};
+          if (1 + labelLen_ + it_->second.argsLen > header_.len) continue;
+          event_.site = &it_->second;
+          event_.label = {reinterpret_cast<const char*>(payload_ + 1),
+                          labelLen_};
+          event_.args = payload_ + 1 + labelLen_;
+          func(event_);
+        } else if (header_.tag == EntryTag::DROP) {
+          if (header_.len < sizeof(event_.dropped)) continue;
+          std::memcpy(&event_.dropped, payload_, sizeof(event_.dropped));
+          func(event_);
+        } else {
+          break;
+        }
+      }
+    }
+  };
+
+ private:
+  /**
+   * @brief   Parses the payload of a SITE entry.
+   *
+   * @param   payload The payload
+   * @param   len     The payload length from the entry header
+   * @return          The call site, or std::nullopt if a field overruns len,
+   *                  a type code is unknown or the types do not add up to
+   *                  the argument length
+   */
+  static std::optional<TraceSite> parse_site(const std::byte* payload,
+                                             std::size_t len) {
+    TraceSite site_{};
+    std::size_t pos_{0};
+    auto get_ = [&](void* dst, std::size_t n) {
+      if (n > len - pos_) return false;
+      std::memcpy(dst, payload + pos_, n);
+      pos_ += n;
+      return true;
+    };
+    auto get_str_ = [&](std::string& str) {
+      std::uint16_t n_{};
+      if (!get_(&n_, sizeof(n_)) || n_ > len - pos_) return false;
+      str.assign(reinterpret_cast<const char*>(payload + pos_), n_);
+      pos_ += n_;
+      return true;
+    };
+    std::uint8_t count_{};
+    if (!get_(&site_.kind, 1) || !get_(&count_, 1) ||
+        !get_(&site_.argsLen, sizeof(site_.argsLen)))
+      return std::nullopt;
+    site_.types.resize(count_);
+    if (!get_(site_.types.data(), count_) || !get_str_(site_.func) ||
+        !get_str_(site_.color) || !get_str_(site_.names))
+      return std::nullopt;
+    const std::array<std::byte, sizeof(long double)> zero_{};
+    std::size_t argsLen_{0};
+    for (const auto type_ : site_.types) {
+      const std::size_t size_{visit_value(type_, zero_.data(), [](auto) {})};
+      if (size_ == 0) return std::nullopt;
+      argsLen_ += size_;
+    }
+    if (argsLen_ != site_.argsLen) return std::nullopt;
+    return site_;
+  };
+};
+
+/**
+ * @brief   Rebuilds the text the asynchronous text sink prints for an event.
+ *
+ * @param   buf   The format buffer (cleared by the caller)
+ * @param   event The event
+ * @return        View of the formatted text, owned by the buffer
+ *
+ * @details Uses the same stream_var() and r2d2_format::paint() as
+ *          stream_args and the FUNC macros, so the text matches.
+ */
+inline std::string_view format_event(r2d2_format::FormatBuffer& buf,
+                                     const TraceEvent& event) {
+  if (!event.site)
+    return buf.append(ANSI_RED "Dropped ")
+        .append_value(event.dropped)
+        .append(" debug record(s)!" ANSI_RESET)
+        .view();
+  const TraceSite& site{*event.site};
+  using r2d2_async::SiteKind;
+  if (!event.label.empty()) buf.append("[").append(event.label).append("] ");
+  const VarNames names_{site.names};
+  const bool func_{site.kind == SiteKind::FUNC};
+  const std::size_t first_{func_ ? std::size_t{1} : 0};
+  const std::size_t sz_{site.types.size() - std::min(first_,
+                                                     site.types.size())};
+  std::size_t offset_{0};
+  if (site.kind != SiteKind::VARS) buf.append(site.func).append("(");
+  const std::size_t outputLen_{
+      func_ && !site.types.empty()
+          ? visit_value(site.types[0], event.args, [](auto) {})
+          : 0};
+  offset_ = outputLen_;
+  for (std::size_t i = 0; i < sz_; ++i)
+    offset_ += visit_value(
+        site.types[first_ + i], event.args + offset_, [&](auto value) {
+          stream_var(buf, site.color, names_[first_ + i], value, i, sz_);
+        });
+  if (site.kind == SiteKind::VOID) buf.append(")");
+  if (func_ && outputLen_ > 0) {
+    buf.append(") : ");
+    visit_value(site.types[0], event.args, [&](auto value) {
+      buf.append(r2d2_format::paint(ANSI_WHITE, value).view());
+    });
+  }
+  return buf.view();
+};
+}  // namespace r2d2_trace
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_TRACE_HPP_
@@ -1,6 +1,8 @@
 #ifndef INCLUDE_R2D2_UTILS_PKG_POLYNOME_HPP_
 #define INCLUDE_R2D2_UTILS_PKG_POLYNOME_HPP_
 
+#include <array>
+#include <cstddef>
 #include <type_traits>
 
 namespace horner {
@@ -24,5 +26,31 @@ template <template <typename> class Vector, typename T>
   for (std::size_t i = 1; i < coeffs.size(); i++) acc = acc * x + coeffs[i];
   return acc;
 };
+
+/**
+ * @brief   Evaluates a polynomial with a fixed number of coefficients.
+ *
+ * @tparam  T      Numeric type
+ * @tparam  N      The number of coefficients
+ * @param   coeffs Array of polynomial coefficients (highest degree first)
+ * @param   x      The value to evaluate the polynomial at
+ * @return         The result of the polynomial evaluation
+ *
+ * @details The degree is known at compile time, so the loop is unrolled and
+ *          constexpr coefficients (e.g. generated configs) are folded into
+ *          the code. Returns 0 if N is 0.
+ */
+template <typename T, std::size_t N>
+[[nodiscard]] constexpr T polynome(const std::array<T, N>& coeffs,
+                                   const T& x) {
+  static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type!");
+  if constexpr (N == 0) {
+    return T{};
+  } else {
+    T acc{coeffs[0]};
+    for (std::size_t i = 1; i < N; i++) acc = acc * x + coeffs[i];
+    return acc;
+  }
+};
 }  // namespace horner
 #endif  // INCLUDE_R2D2_UTILS_PKG_POLYNOME_HPP_
@@ -0,0 +1,117 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_STATICCONFIG_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_STATICCONFIG_HPP_
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+#include "Errors/Result.hpp"
+#include "Exceptions.hpp"
+#include "Strings.hpp"
+
+namespace r2d2_static {
+/**
+ * @brief   Converts a compiled-in configuration object to its runtime type.
+ *
+ * @tparam  Type  The runtime configuration type (e.g. config::joint_t<T>)
+ * @tparam  Value The constexpr object
+ * @return        The converted object
+ */
+template <typename Type, const auto& Value>
+Type make() {
+  return Value;
+};
+
+/**
+ * @brief   Key and factory of one compiled-in configuration object.
+ *
+ * @tparam  Type The runtime configuration type
+ */
+template <typename Type>
+struct Entry {
+  std::string_view key;
+  Type (*make)();
+};
+
+/**
+ * @brief   Compiled-in replacement for IJsonConfigMap.
+ *
+ * @tparam  Type The configuration type template
+ * @tparam  T    Numeric type for the configuration values
+ * @tparam  N    The number of objects
+ *
+ * @details Tables are written by tools/gen_config.cpp (see the
+ *          r2d2_generate_config() CMake function and tools/example) as
+ *          constexpr objects, so nothing is parsed or allocated at startup.
+ *          getParams() and try_getParams() behave like their IJsonConfigMap
+ *          counterparts, including the ASCII case-insensitive keys, so
+ *          switching a node to a generated table only changes the type it
+ *          holds. Code that can name the object directly should use the
+ *          generated constexpr variable instead, which lets the compiler
+ *          fold its values.
+ */
+template <template <typename> class Type, typename T, std::size_t N>
+class ConfigMap {
+ private:
+  std::array<Entry<Type<T>>, N> m_entries;
+
+ public:
+  /**
+   * @brief   Constructs a ConfigMap.
+   *
+   * @param   entries The keys and factories of the objects
+   */
+  constexpr explicit ConfigMap(const std::array<Entry<Type<T>>, N>& entries)
+      : m_entries{entries} {};
+
+  /**
+   * @brief   Gets the index of a key.
+   *
+   * @param   key The configuration key
+   * @return      The index, or N if the key is not found
+   */
+  [[nodiscard]] constexpr std::size_t find(std::string_view key) const {
+    for (std::size_t i = 0; i < N; ++i)
+      if (r2d2_string::iequals(m_entries[i].key, key)) return i;
+    return N;
+  };
+
+  [[nodiscard]] constexpr bool contains(std::string_view key) const {
+    return find(key) != N;
+  };
+
+  /**
+   * @brief   Gets a configuration object by key.
+   *
+   * @param   key The configuration key
+   * @return      The configuration object of type Type<T>
+   *
+   * @throws  r2d2_errors::json::ObjectParseError if the key is not found
+   */
+  [[nodiscard]] Type<T> getParams(std::string_view key) const {
+    if (auto result_ = try_getParams(key)) return *std::move(result_);
+    throw r2d2_errors::json::ObjectParseError{key};
+  };
+
+  /**
+   * @brief   Gets a configuration object by key without throwing.
+   *
+   * @param   key The configuration key
+   * @return      Result holding the configuration object, or
+   *              r2d2_errors::ErrorCode::OBJECT_PARSE if the key is not found
+   */
+  [[nodiscard]] r2d2_errors::Result<Type<T>> try_getParams(
+      std::string_view key) const {
+    if (const auto i_ = find(key); i_ != N) return m_entries[i_].make();
+    return r2d2_errors::fail(r2d2_errors::ErrorCode::OBJECT_PARSE);
+  };
+
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return N; };
+  [[nodiscard]] constexpr std::string_view key(std::size_t index) const {
+    return m_entries[index].key;
+  };
+};
+}  // namespace r2d2_static
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_STATICCONFIG_HPP_
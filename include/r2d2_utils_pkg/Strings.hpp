@@ -3,10 +3,110 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace r2d2_string {
+namespace ascii {
+constexpr char CASE_BIT{0x20};
+
+/**
+ * @brief   Converts the ASCII letters of a character range to one case.
+ *
+ * @tparam  Upper True to convert to uppercase, false for lowercase
+ * @param   src   The source characters
+ * @param   dst   The destination (may be equal to src)
+ * @param   len   The number of characters
+ *
+ * @details Only 'a'-'z' (or 'A'-'Z') change; every other byte, including
+ *          non-ASCII ones, is copied as is. Processes 32 bytes per step with
+ *          AVX2 or 16 with SSE2 when the build enables them, by flipping the
+ *          case bit of bytes that fall in the letter range.
+ */
+template <bool Upper>
+inline void convert(const char* src, char* dst, std::size_t len) noexcept {
+  constexpr char first_{Upper ? 'a' : 'A'};
+  std::size_t i{0};
+#if defined(__AVX2__)
+  const __m256i shift32_{_mm256_set1_epi8(static_cast<char>(-128 - first_))};
+  const __m256i limit32_{_mm256_set1_epi8(static_cast<char>(-128 + 26))};
+  const __m256i bit32_{_mm256_set1_epi8(CASE_BIT)};
+  for (; i + 32 <= len; i += 32) {
+    const __m256i chars_{
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))};
+    const __m256i letters_{_mm256_cmpgt_epi8(
+        limit32_, _mm256_add_epi8(chars_, shift32_))};
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(dst + i),
+        _mm256_xor_si256(chars_, _mm256_and_si256(letters_, bit32_)));
+  }
+#endif
+#if defined(__AVX2__) || defined(__SSE2__)
+  const __m128i shift_{_mm_set1_epi8(static_cast<char>(-128 - first_))};
+  const __m128i limit_{_mm_set1_epi8(static_cast<char>(-128 + 26))};
+  const __m128i bit_{_mm_set1_epi8(CASE_BIT)};
+  for (; i + 16 <= len; i += 16) {
+    const __m128i chars_{
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))};
+    const __m128i letters_{
+        _mm_cmplt_epi8(_mm_add_epi8(chars_, shift_), limit_)};
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_xor_si128(chars_, _mm_and_si128(letters_, bit_)));
+  }
+#endif
+  for (; i < len; ++i) {
+    const char chr_{src[i]};
+    dst[i] = static_cast<unsigned char>(chr_ - first_) < 26
+                 ? static_cast<char>(chr_ ^ CASE_BIT)
+                 : chr_;
+  }
+};
+
+/**
+ * @brief   Resolves the from/to range of a string of the given length.
+ *
+ * @param   len  The string length
+ * @param   from Start index
+ * @param   to   End index (npos means end of string)
+ * @return       The end index
+ */
+inline std::size_t range_end(std::size_t len, std::size_t from,
+                             std::size_t to) noexcept {
+  if (to == std::string_view::npos) to = len;
+  assert(from <= len);
+  assert(to >= from && to <= len);
+  return to;
+};
+
+/**
+ * @brief   Copies a string into a buffer, converting the case of a range.
+ *
+ * @tparam  Upper True to convert to uppercase, false for lowercase
+ * @param   sv   The source string
+ * @param   dst  The destination buffer, at least sv.length() characters
+ * @param   from Start index
+ * @param   to   End index (npos means end of string)
+ */
+template <bool Upper>
+inline void convert_into(std::string_view sv, char* dst, std::size_t from,
+                         std::size_t to) noexcept {
+  to = range_end(sv.length(), from, to);
+  if (sv.empty()) return;
+  std::memcpy(dst, sv.data(), from);
+  convert<Upper>(sv.data() + from, dst + from, to - from);
+  std::memcpy(dst + to, sv.data() + to, sv.length() - to);
+};
+}  // namespace ascii
+
 /**
  * @brief   Transforms a substring of a string view using a transformation
  *          function.
@@ -44,11 +144,15 @@ inline std::string transform_string(std::string_view sv, TransformFunc func,
  * @param   from Start index (default: 0)
  * @param   to   End index (default: npos, meaning end of string)
  * @return       A new string with the specified substring in uppercase
+ *
+ * @details ASCII only, like ::toupper in the default "C" locale.
  */
 [[nodiscard]]
 inline std::string upper(std::string_view sv, size_t from = 0,
                          size_t to = std::string_view::npos) {
-  return transform_string(sv, ::toupper, from, to);
+  std::string str_(sv.length(), '\0');
+  ascii::convert_into<true>(sv, str_.data(), from, to);
+  return str_;
 };
 
 /**
@@ -58,11 +162,218 @@ inline std::string upper(std::string_view sv, size_t from = 0,
  * @param   from Start index (default: 0)
  * @param   to   End index (default: npos, meaning end of string)
  * @return       A new string with the specified substring in lowercase
+ *
+ * @details ASCII only, like ::tolower in the default "C" locale.
  */
 [[nodiscard]]
 inline std::string lower(std::string_view sv, size_t from = 0,
                          size_t to = std::string_view::npos) {
-  return transform_string(sv, ::tolower, from, to);
+  std::string str_(sv.length(), '\0');
+  ascii::convert_into<false>(sv, str_.data(), from, to);
+  return str_;
+};
+
+/**
+ * @brief   Converts a substring to uppercase in place.
+ *
+ * @param   data The mutable characters
+ * @param   len  The number of characters
+ * @param   from Start index (default: 0)
+ * @param   to   End index (default: npos, meaning end of string)
+ */
+inline void upper_in_place(char* data, size_t len, size_t from = 0,
+                           size_t to = std::string_view::npos) noexcept {
+  to = ascii::range_end(len, from, to);
+  ascii::convert<true>(data + from, data + from, to - from);
+};
+inline void upper_in_place(std::string& str, size_t from = 0,
+                           size_t to = std::string_view::npos) noexcept {
+  upper_in_place(str.data(), str.length(), from, to);
+};
+
+/**
+ * @brief   Converts a substring to lowercase in place.
+ *
+ * @param   data The mutable characters
+ * @param   len  The number of characters
+ * @param   from Start index (default: 0)
+ * @param   to   End index (default: npos, meaning end of string)
+ */
+inline void lower_in_place(char* data, size_t len, size_t from = 0,
+                           size_t to = std::string_view::npos) noexcept {
+  to = ascii::range_end(len, from, to);
+  ascii::convert<false>(data + from, data + from, to - from);
+};
+inline void lower_in_place(std::string& str, size_t from = 0,
+                           size_t to = std::string_view::npos) noexcept {
+  lower_in_place(str.data(), str.length(), from, to);
+};
+
+/**
+ * @brief   Copies a string into a caller-provided buffer with a substring
+ *          converted to uppercase.
+ *
+ * @param   sv   The string view to convert
+ * @param   dst  The destination buffer
+ * @param   cap  The capacity of the destination buffer
+ * @param   from Start index (default: 0)
+ * @param   to   End index (default: npos, meaning end of string)
+ * @return       The number of characters written (sv.length()), or 0 if the
+ *               buffer is too small
+ *
+ * @details No null terminator is written.
+ */
+inline size_t upper_into(std::string_view sv, char* dst, size_t cap,
+                         size_t from = 0,
+                         size_t to = std::string_view::npos) noexcept {
+  if (cap < sv.length()) return 0;
+  ascii::convert_into<true>(sv, dst, from, to);
+  return sv.length();
+};
+
+/**
+ * @brief   Copies a string into a caller-provided buffer with a substring
+ *          converted to lowercase.
+ *
+ * @param   sv   The string view to convert
+ * @param   dst  The destination buffer
+ * @param   cap  The capacity of the destination buffer
+ * @param   from Start index (default: 0)
+ * @param   to   End index (default: npos, meaning end of string)
+ * @return       The number of characters written (sv.length()), or 0 if the
+ *               buffer is too small
+ *
+ * @details No null terminator is written.
+ */
+inline size_t lower_into(std::string_view sv, char* dst, size_t cap,
+                         size_t from = 0,
+                         size_t to = std::string_view::npos) noexcept {
+  if (cap < sv.length()) return 0;
+  ascii::convert_into<false>(sv, dst, from, to);
+  return sv.length();
+};
+
+/**
+ * @brief   Assigns a string to a reused output string with a substring
+ *          converted to uppercase.
+ *
+ * @param   sv   The string view to convert
+ * @param   out  The output string (its capacity is reused)
+ * @param   from Start index (default: 0)
+ * @param   to   End index (default: npos, meaning end of string)
+ * @return       Reference to out
+ */
+inline std::string& upper_into(std::string_view sv, std::string& out,
+                               size_t from = 0,
+                               size_t to = std::string_view::npos) {
+  out.resize(sv.length());
+  ascii::convert_into<true>(sv, out.data(), from, to);
+  return out;
+};
+
+/**
+ * @brief   Assigns a string to a reused output string with a substring
+ *          converted to lowercase.
+ *
+ * @param   sv   The string view to convert
+ * @param   out  The output string (its capacity is reused)
+ * @param   from Start index (default: 0)
+ * @param   to   End index (default: npos, meaning end of string)
+ * @return       Reference to out
+ */
+inline std::string& lower_into(std::string_view sv, std::string& out,
+                               size_t from = 0,
+                               size_t to = std::string_view::npos) {
+  out.resize(sv.length());
+  ascii::convert_into<false>(sv, out.data(), from, to);
+  return out;
+};
+
+/**
+ * @brief   Folds an ASCII character to lowercase.
+ *
+ * @param   chr The character
+ * @return      The lowercase letter for 'A'-'Z', the character otherwise
+ */
+constexpr char fold(char chr) noexcept {
+  return static_cast<unsigned char>(chr - 'A') < 26
+             ? static_cast<char>(chr ^ ascii::CASE_BIT)
+             : chr;
+};
+
+/**
+ * @brief   Compares two strings for equality, ignoring ASCII case.
+ *
+ * @param   lhs The first string
+ * @param   rhs The second string
+ * @return      True if the strings are equal up to ASCII case
+ */
+constexpr bool iequals(std::string_view lhs, std::string_view rhs) noexcept {
+  if (lhs.size() != rhs.size()) return false;
+  for (size_t i = 0; i < lhs.size(); ++i)
+    if (fold(lhs[i]) != fold(rhs[i])) return false;
+  return true;
+};
+
+/**
+ * @brief   Compares two strings lexicographically, ignoring ASCII case.
+ *
+ * @param   lhs The first string
+ * @param   rhs The second string
+ * @return      Negative, zero or positive like std::string_view::compare
+ */
+constexpr int icompare(std::string_view lhs, std::string_view rhs) noexcept {
+  const size_t size_{std::min(lhs.size(), rhs.size())};
+  for (size_t i = 0; i < size_; ++i) {
+    const auto lhsChr_{static_cast<unsigned char>(fold(lhs[i]))};
+    const auto rhsChr_{static_cast<unsigned char>(fold(rhs[i]))};
+    if (lhsChr_ != rhsChr_) return lhsChr_ < rhsChr_ ? -1 : 1;
+  }
+  return lhs.size() == rhs.size() ? 0 : (lhs.size() < rhs.size() ? -1 : 1);
+};
+
+/**
+ * @brief   Hashes a string after folding it to lowercase.
+ *
+ * @param   sv The string
+ * @return     FNV-1a hash of the folded string, equal for strings that
+ *             iequals() considers equal
+ */
+constexpr size_t ihash(std::string_view sv) noexcept {
+  std::uint64_t hash_{14695981039346656037ULL};
+  for (const char chr_ : sv) {
+    hash_ ^= static_cast<unsigned char>(fold(chr_));
+    hash_ *= 1099511628211ULL;
+  }
+  return static_cast<size_t>(hash_);
+};
+
+/**
+ * @brief   Transparent case-insensitive hasher for string keys.
+ */
+struct CaseInsensitiveHash {
+  using is_transparent = void;
+  size_t operator()(std::string_view sv) const noexcept { return ihash(sv); };
+};
+
+/**
+ * @brief   Transparent case-insensitive equality for string keys.
+ */
+struct CaseInsensitiveEqual {
+  using is_transparent = void;
+  bool operator()(std::string_view lhs, std::string_view rhs) const noexcept {
+    return iequals(lhs, rhs);
+  };
+};
+
+/**
+ * @brief   Transparent case-insensitive ordering for string keys.
+ */
+struct CaseInsensitiveLess {
+  using is_transparent = void;
+  bool operator()(std::string_view lhs, std::string_view rhs) const noexcept {
+    return icompare(lhs, rhs) < 0;
+  };
 };
 }  // namespace r2d2_string
 
@@ -0,0 +1,251 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_SYMBOLS_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_SYMBOLS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Strings.hpp"
+
+namespace r2d2_symbol {
+/**
+ * @brief   Interned text with its precomputed hash and id.
+ */
+struct SymbolData {
+  std::string text;
+  std::size_t hash;
+  std::uint32_t id;
+};
+
+/**
+ * @brief   Handle to an interned string.
+ *
+ * @details A Symbol is a pointer into the process-wide pool, so copying,
+ *          comparing and hashing it are single integer operations. The text
+ *          lives until the process exits. A default-constructed Symbol is
+ *          empty and compares unequal to every interned one.
+ */
+class Symbol {
+ private:
+  const SymbolData* m_data{nullptr};
+
+ public:
+  constexpr Symbol() noexcept = default;
+  constexpr explicit Symbol(const SymbolData* data) noexcept : m_data{data} {};
+
+  /**
+   * @brief   Interns a string and constructs its Symbol.
+   *
+   * @param   text The text to intern
+   */
+  explicit Symbol(std::string_view text);
+
+  [[nodiscard]] std::string_view str() const noexcept {
+    return m_data ? std::string_view{m_data->text} : std::string_view{};
+  };
+  [[nodiscard]] const char* c_str() const noexcept {
+    return m_data ? m_data->text.c_str() : "";
+  };
+  [[nodiscard]] std::size_t hash() const noexcept {
+    return m_data ? m_data->hash : 0;
+  };
+  [[nodiscard]] std::uint32_t id() const noexcept {
+    return m_data ? m_data->id : 0;
+  };
+  [[nodiscard]] bool empty() const noexcept { return m_data == nullptr; };
+  explicit operator bool() const noexcept { return m_data != nullptr; };
+  operator std::string_view() const noexcept { return str(); };
+
+  friend bool operator==(Symbol lhs, Symbol rhs) noexcept {
+    return lhs.m_data == rhs.m_data;
+  };
+  friend bool operator!=(Symbol lhs, Symbol rhs) noexcept {
+    return lhs.m_data != rhs.m_data;
+  };
+  friend bool operator<(Symbol lhs, Symbol rhs) noexcept {
+    return lhs.id() < rhs.id();
+  };
+};
+
+/**
+ * @brief   Handle to a string interned ignoring ASCII case.
+ *
+ * @details Only the folded functions of SymbolPool construct a non-empty
+ *          FoldedSymbol, so maps keyed on it cannot be filled or searched
+ *          with an exact Symbol, which would silently miss. It converts to
+ *          the Symbol of the first spelling of the text.
+ */
+class FoldedSymbol {
+ private:
+  Symbol m_symbol{};
+
+  constexpr explicit FoldedSymbol(Symbol symbol) noexcept
+      : m_symbol{symbol} {};
+
+  friend class SymbolPool;
+
+ public:
+  constexpr FoldedSymbol() noexcept = default;
+
+  [[nodiscard]] Symbol symbol() const noexcept { return m_symbol; };
+  [[nodiscard]] std::string_view str() const noexcept {
+    return m_symbol.str();
+  };
+  [[nodiscard]] const char* c_str() const noexcept {
+    return m_symbol.c_str();
+  };
+  [[nodiscard]] std::size_t hash() const noexcept { return m_symbol.hash(); };
+  [[nodiscard]] bool empty() const noexcept { return m_symbol.empty(); };
+  explicit operator bool() const noexcept { return !m_symbol.empty(); };
+  operator Symbol() const noexcept { return m_symbol; };
+
+  friend bool operator==(FoldedSymbol lhs, FoldedSymbol rhs) noexcept {
+    return lhs.m_symbol == rhs.m_symbol;
+  };
+  friend bool operator!=(FoldedSymbol lhs, FoldedSymbol rhs) noexcept {
+    return lhs.m_symbol != rhs.m_symbol;
+  };
+  friend bool operator<(FoldedSymbol lhs, FoldedSymbol rhs) noexcept {
+    return lhs.m_symbol < rhs.m_symbol;
+  };
+};
+
+/**
+ * @brief   Process-wide pool of interned strings.
+ *
+ * @details Interning the same text twice yields the same Symbol. The folded
+ *          variants ignore ASCII case and return the Symbol of the spelling
+ *          interned first, so maps keyed on them match names
+ *          case-insensitively. Lookups take a shared lock and never
+ *          allocate; only the first interning of a text does.
+ */
+class SymbolPool {
+ private:
+  mutable std::shared_mutex m_mutex{};
+  std::deque<SymbolData> m_symbols{};
+  std::unordered_map<std::string_view, const SymbolData*> m_exact{};
+  std::unordered_map<std::string_view, const SymbolData*,
+                     r2d2_string::CaseInsensitiveHash,
+                     r2d2_string::CaseInsensitiveEqual>
+      m_folded{};
+
+ public:
+  /**
+   * @brief   Interns a string.
+   *
+   * @param   text The text to intern
+   * @return       The Symbol of the text
+   */
+  Symbol intern(std::string_view text) {
+    if (const Symbol symbol_{find(text)}) return symbol_;
+    std::unique_lock lock_{m_mutex};
+    return Symbol{insert(text)};
+  };
+
+  /**
+   * @brief   Interns a string ignoring ASCII case.
+   *
+   * @param   text The text to intern
+   * @return       The folded symbol of the first spelling of the text
+   */
+  FoldedSymbol intern_folded(std::string_view text) {
+    if (const FoldedSymbol symbol_{find_folded(text)}) return symbol_;
+    std::unique_lock lock_{m_mutex};
+    if (const auto it_{m_folded.find(text)}; it_ != m_folded.end())
+      return FoldedSymbol{Symbol{it_->second}};
+    const SymbolData* data_{insert(text)};
+    m_folded.emplace(data_->text, data_);
+    return FoldedSymbol{Symbol{data_}};
+  };
+
+  /**
+   * @brief   Finds an interned string.
+   *
+   * @param   text The text to find
+   * @return       The Symbol of the text, or an empty Symbol
+   */
+  [[nodiscard]] Symbol find(std::string_view text) const {
+    std::shared_lock lock_{m_mutex};
+    const auto it_{m_exact.find(text)};
+    return it_ == m_exact.end() ? Symbol{} : Symbol{it_->second};
+  };
+
+  /**
+   * @brief   Finds a string interned with intern_folded(), ignoring ASCII
+   *          case.
+   *
+   * @param   text The text to find
+   * @return       The folded symbol of the first spelling, or an empty one
+   */
+  [[nodiscard]] FoldedSymbol find_folded(std::string_view text) const {
+    std::shared_lock lock_{m_mutex};
+    const auto it_{m_folded.find(text)};
+    return it_ == m_folded.end() ? FoldedSymbol{}
+                                 : FoldedSymbol{Symbol{it_->second}};
+  };
+
+  [[nodiscard]] std::size_t size() const {
+    std::shared_lock lock_{m_mutex};
+    return m_symbols.size();
+  };
+
+ private:
+  const SymbolData* insert(std::string_view text) {
+    if (const auto it_{m_exact.find(text)}; it_ != m_exact.end())
+      return it_->second;
+    const SymbolData& data_{m_symbols.emplace_back(
+        SymbolData{std::string{text}, r2d2_string::ihash(text),
+                   static_cast<std::uint32_t>(m_symbols.size() + 1)})};
+    m_exact.emplace(data_.text, &data_);
+    return &data_;
+  };
+};
+
+/**
+ * @brief   Gets the process-wide symbol pool.
+ *
+ * @return  Reference to the pool
+ *
+ * @details The pool is never destroyed, so Symbols held by static objects
+ *          stay valid during static destruction.
+ */
+inline SymbolPool& pool() {
+  static SymbolPool* pool_{new SymbolPool{}};
+  return *pool_;
+};
+
+inline Symbol intern(std::string_view text) { return pool().intern(text); };
+inline FoldedSymbol intern_folded(std::string_view text) {
+  return pool().intern_folded(text);
+};
+inline Symbol find(std::string_view text) { return pool().find(text); };
+inline FoldedSymbol find_folded(std::string_view text) {
+  return pool().find_folded(text);
+};
+
+inline Symbol::Symbol(std::string_view text) : Symbol{intern(text)} {};
+}  // namespace r2d2_symbol
+
+namespace std {
+template <>
+struct hash<r2d2_symbol::Symbol> {
+  size_t operator()(r2d2_symbol::Symbol symbol) const noexcept {
+    return symbol.hash();
+  };
+};
+
+template <>
+struct hash<r2d2_symbol::FoldedSymbol> {
+  size_t operator()(r2d2_symbol::FoldedSymbol symbol) const noexcept {
+    return symbol.hash();
+  };
+};
+}  // namespace std
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_SYMBOLS_HPP_
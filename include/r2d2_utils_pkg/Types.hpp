@@ -3,8 +3,13 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include "Enums.hpp"
+
 namespace r2d2_commands {
 enum class ControlType : uint16_t {
   HOLD = 0x00,
@@ -17,67 +22,79 @@ enum class ControlType : uint16_t {
 namespace r2d2_state {
 enum class WorkMode : uint8_t { NONE = 0, SETUP, AUTO, STOP = 0x80 };
 enum class NozzleType : uint8_t { NONE = 0, EMA, BRUSH };
+}  // namespace r2d2_state
+
+namespace r2d2_enum {
+template <>
+struct EnumTraits<r2d2_commands::ControlType> {
+  using E = r2d2_commands::ControlType;
+  static constexpr auto table{make_table<E>({{E::HOLD, "hold"},
+                                             {E::CONTROL_SPEED, "speed"},
+                                             {E::CONTROL_ANGLE, "angle"},
+                                             {E::CHECK_ID, "check_id"}})};
+};
+template <>
+struct EnumTraits<r2d2_state::WorkMode> {
+  using E = r2d2_state::WorkMode;
+  static constexpr auto table{make_table<E>({{E::NONE, "none"},
+                                             {E::SETUP, "setup"},
+                                             {E::AUTO, "auto"},
+                                             {E::STOP, "stop"}})};
+};
+template <>
+struct EnumTraits<r2d2_state::NozzleType> {
+  using E = r2d2_state::NozzleType;
+  static constexpr auto table{make_table<E>(
+      {{E::NONE, "none"}, {E::EMA, "ema"}, {E::BRUSH, "brush"}})};
+};
+}  // namespace r2d2_enum
 
+namespace r2d2_state {
 /**
  * @brief   Template struct that pairs an enum type with its string key
  *          representation.
  *
  * @tparam  E The enum type
  *
- * @details Maintains synchronization between enum values and their string keys.
+ * @details Trivially copyable; the key is derived from the enum type on
+ *          demand and points into static storage.
  */
 template <typename E>
 struct EnumPair {
   E type{};
-  std::string key{};
 
   /**
-   * @brief   Updates the enum type and synchronizes the key.
+   * @brief   Updates the enum type.
    *
    * @tparam  T     The value type
    * @param   value The enum value to set
    */
   template <typename T>
-  void updateType(const T value) {
+  constexpr void updateType(const T value) noexcept {
     type = static_cast<E>(value);
-    updateKey();
   };
 
   /**
-   * @brief   Updates the key string based on the current enum type.
+   * @brief   Gets the key string of the current enum type.
    *
-   * @details Must be specialized for each enum type.
+   * @return  The key (the enum name unless specialized)
    */
-  void updateKey();
+  [[nodiscard]] constexpr std::string_view key() const noexcept {
+    return r2d2_enum::to_string(type);
+  };
 };
 
 typedef EnumPair<WorkMode> WorkModePair;
 typedef EnumPair<NozzleType> NozzleTypePair;
 
 template <>
-inline void WorkModePair::updateKey() {
-  switch (type) {
-    case WorkMode::SETUP:
-    case WorkMode::AUTO:
-    case WorkMode::STOP:
-      key = "none";
-      break;
-    default:
-      key = "";
-  }
+constexpr std::string_view WorkModePair::key() const noexcept {
+  return type == WorkMode::NONE ? std::string_view{} : "none";
 };
 template <>
-inline void NozzleTypePair::updateKey() {
-  switch (type) {
-    case NozzleType::BRUSH:
-      key = "brush";
-      break;
-    case NozzleType::EMA:
-      key = "ema";
-      break;
-    default:
-      key = "";
-  }
+constexpr std::string_view NozzleTypePair::key() const noexcept {
+  return type == NozzleType::NONE ? std::string_view{}
+                                  : r2d2_enum::to_string(type);
 };
 }  // namespace r2d2_state
 
@@ -210,6 +227,50 @@ struct pipe_t {
  */
 template <typename T>
 using nozzle_t = nozzlebase_t<T, T>;
+
+/**
+ * @brief   Names and member pointers of a configuration structure.
+ *
+ * @tparam  Config The configuration structure
+ *
+ * @details fields is a tuple of (name, member pointer) pairs in declaration
+ *          order, so that aggregate initialization can be written from it.
+ *          tools/gen_config.cpp uses it to generate constexpr configurations
+ *          from JSON; keep it in sync when a structure changes.
+ */
+template <typename Config>
+struct FieldTraits;
+
+template <typename T>
+struct FieldTraits<payload_t<T>> {
+  static constexpr auto fields{
+      std::make_tuple(std::pair{"stiffness", &payload_t<T>::stiffness})};
+};
+
+template <typename T>
+struct FieldTraits<joint_t<T>> {
+  static constexpr auto fields{std::make_tuple(
+      std::pair{"length", &joint_t<T>::length},
+      std::pair{"speed", &joint_t<T>::speed},
+      std::pair{"angle_offset", &joint_t<T>::angle_offset},
+      std::pair{"angle_tolerance", &joint_t<T>::angle_tolerance},
+      std::pair{"coeffs", &joint_t<T>::coeffs})};
+};
+
+template <typename T>
+struct FieldTraits<pipe_t<T>> {
+  static constexpr auto fields{
+      std::make_tuple(std::pair{"diameter", &pipe_t<T>::diameter},
+                      std::pair{"thickness", &pipe_t<T>::thickness})};
+};
+
+template <typename T>
+struct FieldTraits<nozzle_t<T>> {
+  static constexpr auto fields{std::make_tuple(
+      std::pair{"force_needed", &nozzle_t<T>::force_needed},
+      std::pair{"force_tolerance", &nozzle_t<T>::force_tolerance},
+      std::pair{"r0", &nozzle_t<T>::r0})};
+};
 }  // namespace r2d2_type::config
 
 #endif  // INCLUDE_R2D2_UTILS_PKG_TYPES_HPP_
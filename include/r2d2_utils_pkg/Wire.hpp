@@ -0,0 +1,246 @@
+#ifndef INCLUDE_R2D2_UTILS_PKG_WIRE_HPP_
+#define INCLUDE_R2D2_UTILS_PKG_WIRE_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "Types.hpp"
+
+namespace r2d2_type::wire {
+enum class ByteOrder : uint8_t { LITTLE, BIG };
+
+/**
+ * @brief   Integer or enum field stored as raw bytes in a fixed byte order.
+ *
+ * @tparam  T     The field type
+ * @tparam  Order The byte order on the wire
+ *
+ * @details Has alignment 1 and no padding, so structs of fields overlay a
+ *          byte buffer at any offset. get() assembles the bytes with shifts,
+ *          which compilers lower to a single load (plus a byte swap when the
+ *          order differs from the host). Deliberately left uninitialized so
+ *          that it stays trivial.
+ */
+template <typename T, ByteOrder Order = ByteOrder::LITTLE>
+class Field {
+  static_assert(std::is_integral_v<T> || std::is_enum_v<T>,
+                "Field requires an integral or enum type");
+
+ private:
+  using Raw = std::make_unsigned_t<
+      typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>,
+                                  std::common_type<T>>::type>;
+
+  unsigned char m_bytes[sizeof(T)];
+
+  static constexpr std::size_t shift(std::size_t index) noexcept {
+    return 8 * (Order == ByteOrder::LITTLE ? index : sizeof(T) - 1 - index);
+  };
+
+ public:
+  [[nodiscard]] constexpr T get() const noexcept {
+    Raw raw_{0};
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+      raw_ |= static_cast<Raw>(static_cast<Raw>(m_bytes[i]) << shift(i));
+    return static_cast<T>(raw_);
+  };
+  constexpr void set(const T value) noexcept {
+    const Raw raw_{static_cast<Raw>(value)};
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+      m_bytes[i] = static_cast<unsigned char>(raw_ >> shift(i));
+  };
+  constexpr operator T() const noexcept { return get(); };
+  constexpr Field& operator=(const T value) noexcept {
+    set(value);
+    return *this;
+  };
+};
+
+/**
+ * @brief   Wire layout of a joint state or command: omega, theta and the
+ *          control word, 16 bits each.
+ *
+ * @tparam  Order The byte order on the wire
+ */
+template <ByteOrder Order = ByteOrder::LITTLE>
+struct joint16_t {
+  Field<int16_t, Order> omega;
+  Field<int16_t, Order> theta;
+  Field<uint16_t, Order> control_word;
+
+  [[nodiscard]] constexpr r2d2_commands::ControlType control() const noexcept {
+    return static_cast<r2d2_commands::ControlType>(control_word.get());
+  };
+  [[nodiscard]] constexpr callback::joint16_t decode() const noexcept {
+    return {omega, theta, control_word};
+  };
+};
+
+/**
+ * @brief   Wire layout of a payload reading: a 16-bit force.
+ *
+ * @tparam  Order The byte order on the wire
+ */
+template <ByteOrder Order = ByteOrder::LITTLE>
+struct payload16_t {
+  Field<int16_t, Order> force;
+
+  [[nodiscard]] constexpr callback::payload16_t decode() const noexcept {
+    return {force};
+  };
+};
+
+/**
+ * @brief   Wire layout of a pipe description: a 16-bit diameter and an 8-bit
+ *          thickness.
+ *
+ * @tparam  Order The byte order on the wire
+ */
+template <ByteOrder Order = ByteOrder::LITTLE>
+struct pipe_t {
+  Field<uint16_t, Order> diameter;
+  Field<uint8_t, Order> thickness;
+
+  template <typename T>
+  [[nodiscard]] constexpr callback::pipe_t<T> decode() const noexcept {
+    return {diameter, thickness};
+  };
+};
+
+static_assert(sizeof(joint16_t<>) == 6 && alignof(joint16_t<>) == 1);
+static_assert(sizeof(payload16_t<>) == 2 && alignof(payload16_t<>) == 1);
+static_assert(sizeof(pipe_t<>) == 3 && alignof(pipe_t<>) == 1);
+
+/**
+ * @brief   Overlays a wire struct on a received byte buffer.
+ *
+ * @tparam  W    The wire struct
+ * @param   data The received bytes
+ * @param   size The number of received bytes
+ * @return       Pointer to the overlaid struct, or nullptr if the buffer is
+ *               too short
+ */
+template <typename W>
+[[nodiscard]] const W* view(const void* data, std::size_t size) noexcept {
+  return size < sizeof(W) ? nullptr : static_cast<const W*>(data);
+};
+
+/**
+ * @brief   Contiguous run of wire structs overlaid on a byte buffer.
+ *
+ * @tparam  W The wire struct
+ */
+template <typename W>
+struct FrameSpan {
+  const W* first{nullptr};
+  std::size_t count{0};
+
+  [[nodiscard]] const W* begin() const noexcept { return first; };
+  [[nodiscard]] const W* end() const noexcept { return first + count; };
+  [[nodiscard]] std::size_t size() const noexcept { return count; };
+  [[nodiscard]] const W& operator[](std::size_t index) const noexcept {
+    return first[index];
+  };
+};
+
+/**
+ * @brief   Overlays a run of wire structs on a received byte buffer.
+ *
+ * @tparam  W    The wire struct
+ * @param   data The received bytes
+ * @param   size The number of received bytes
+ * @return       The span of whole structs in the buffer (trailing bytes that
+ *               do not form a whole struct are ignored)
+ */
+template <typename W>
+[[nodiscard]] FrameSpan<W> view_span(const void* data,
+                                     std::size_t size) noexcept {
+  return {static_cast<const W*>(data), size / sizeof(W)};
+};
+
+/**
+ * @brief   Serializes joint commands into a preallocated transmit buffer.
+ *
+ * @tparam  Order The byte order on the wire
+ *
+ * @details Does not own or allocate the buffer. Each write() appends one
+ *          joint16_t frame in place.
+ */
+template <ByteOrder Order = ByteOrder::LITTLE>
+class FrameWriter {
+ private:
+  unsigned char* m_data;
+  std::size_t m_capacity;
+  std::size_t m_size{0};
+
+  /**
+   * @brief   Converts a value to its 16-bit wire form.
+   *
+   * @tparam  T     The value type
+   * @param   value The value
+   * @return        The value rounded and saturated to int16_t
+   *
+   * @details Floating-point values are rounded to nearest, halfway cases away
+   *          from zero, and NaN is sent as 0. Values outside the int16_t range
+   *          saturate at its limits instead of wrapping.
+   */
+  template <typename T>
+  static constexpr int16_t to_wire(const T value) noexcept {
+    constexpr int16_t min_{std::numeric_limits<int16_t>::min()};
+    constexpr int16_t max_{std::numeric_limits<int16_t>::max()};
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(value)) return 0;
+      const T rounded_{std::round(value)};
+      if (rounded_ <= static_cast<T>(min_)) return min_;
+      if (rounded_ >= static_cast<T>(max_)) return max_;
+      return static_cast<int16_t>(rounded_);
+    } else if constexpr (std::is_signed_v<T>) {
+      return static_cast<int16_t>(
+          std::clamp<std::intmax_t>(value, min_, max_));
+    } else {
+      return static_cast<int16_t>(
+          std::min<std::uintmax_t>(value, static_cast<std::uintmax_t>(max_)));
+    }
+  };
+
+ public:
+  /**
+   * @brief   Constructs a writer over a transmit buffer.
+   *
+   * @param   data     The transmit buffer
+   * @param   capacity The size of the buffer in bytes
+   */
+  FrameWriter(void* data, std::size_t capacity) noexcept
+      : m_data{static_cast<unsigned char*>(data)}, m_capacity{capacity} {};
+
+  /**
+   * @brief   Appends a joint command.
+   *
+   * @tparam  T     Type for angular velocity and angle (see to_wire())
+   * @tparam  T1    Type for the control word
+   * @param   joint The joint command
+   * @return        false if the buffer is full
+   */
+  template <typename T, typename T1>
+  bool write(const jointbase_t<T, T1>& joint) noexcept {
+    if (m_capacity - m_size < sizeof(joint16_t<Order>)) return false;
+    auto* frame_{reinterpret_cast<joint16_t<Order>*>(m_data + m_size)};
+    frame_->omega = to_wire(joint.omega);
+    frame_->theta = to_wire(joint.theta);
+    frame_->control_word = static_cast<uint16_t>(joint.control_word);
+    m_size += sizeof(joint16_t<Order>);
+    return true;
+  };
+
+  void clear() noexcept { m_size = 0; };
+  [[nodiscard]] const unsigned char* data() const noexcept { return m_data; };
+  [[nodiscard]] std::size_t size() const noexcept { return m_size; };
+  [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; };
+};
+}  // namespace r2d2_type::wire
+
+#endif  // INCLUDE_R2D2_UTILS_PKG_WIRE_HPP_
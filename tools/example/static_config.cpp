@@ -0,0 +1,25 @@
+/**
+ * @brief   Example consumer of the r2d2_generate_config() CMake function.
+ *
+ * @details Built with the package, so the generator, the CMake function and
+ *          the generated header are exercised by every build. The objects
+ *          of joints.json fold at compile time, and the table returns the
+ *          same objects by key at runtime.
+ */
+#include <cstdio>
+
+#include "r2d2_config/joints.hpp"
+#include "r2d2_utils_pkg/Polynome.hpp"
+
+namespace joints = r2d2_config::joints;
+
+static_assert(joints::shoulder.length == 120.0);
+static_assert(horner::polynome(joints::shoulder.coeffs, 2.0) == 2.0);
+static_assert(joints::table.size() == 2 && joints::table.contains("ELBOW"));
+
+int main() {
+  const auto elbow_{joints::table.getParams("elbow")};
+  std::printf("elbow: length %g, %zu coefficients\n", elbow_.length,
+              elbow_.coeffs.size());
+  return elbow_.coeffs.size() == joints::Elbow.coeffs.size() ? 0 : 1;
+}
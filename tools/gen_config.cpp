@@ -0,0 +1,372 @@
+/**
+ * @brief   Generates a header of constexpr configuration objects from JSON.
+ *
+ * @details Usage: r2d2_gen_config --type TYPE [--value double|float]
+ *                                 [--namespace NS] [--root KEY]
+ *                                 INPUT.json OUTPUT.hpp
+ *
+ *          INPUT maps keys to objects of the r2d2_type::config structure
+ *          TYPE (payload_t, joint_t, pipe_t or nozzle_t); with --root, the
+ *          map is read from that member of the document instead. Fields
+ *          come from r2d2_type::config::FieldTraits: unknown members are an
+ *          error and missing ones keep the structure default.
+ *
+ *          For every key, OUTPUT declares a constexpr object in NS (default
+ *          r2d2_config) and NS::table, an r2d2_static::ConfigMap with the
+ *          getParams() interface of IJsonConfigMap. Structures holding
+ *          vectors are written as NS::Fixed, the same fields with
+ *          std::array members, which converts to the runtime structure.
+ *
+ *          Normally run by the r2d2_generate_config() CMake function.
+ */
+#include <cctype>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "r2d2_utils_pkg/Strings.hpp"
+#include "r2d2_utils_pkg/Types.hpp"
+
+namespace {
+template <typename T>
+struct is_vector : std::false_type {};
+template <typename T>
+struct is_vector<std::vector<T>> : std::true_type {};
+
+/**
+ * @brief   Gets the C++ name of a value type.
+ *
+ * @tparam  T The value type
+ * @return    The type name
+ */
+template <typename T>
+constexpr const char* type_name() {
+  if constexpr (std::is_same_v<T, double>)
+    return "double";
+  else if constexpr (std::is_same_v<T, float>)
+    return "float";
+  else
+    static_assert(std::is_same_v<T, double>, "unsupported value type");
+};
+
+/**
+ * @brief   Writes a value as a C++ literal that reads back exactly.
+ *
+ * @tparam  T     The value type
+ * @param   out   The output stream
+ * @param   value The value
+ */
+template <typename T>
+void write_literal(std::ostream& out, T value) {
+  std::string literal_{};
+  for (int digits_ = std::numeric_limits<T>::digits10;
+       digits_ <= std::numeric_limits<T>::max_digits10; ++digits_) {
+    std::ostringstream oss_;
+    oss_.precision(digits_);
+    oss_ << value;
+    literal_ = oss_.str();
+    T check_{};
+    std::istringstream{literal_} >> check_;
+    if (check_ == value) break;
+  }
+  if (literal_.find_first_of(".en") == std::string::npos) literal_ += ".0";
+  out << literal_;
+};
+
+/**
+ * @brief   Turns a configuration key into a C++ identifier.
+ *
+ * @param   key The configuration key
+ * @return      The key with invalid characters replaced by '_'
+ */
+std::string identifier(std::string_view key) {
+  std::string name_{};
+  for (const char chr : key)
+    name_ += std::isalnum(static_cast<unsigned char>(chr)) ? chr : '_';
+  if (name_.empty() || std::isdigit(static_cast<unsigned char>(name_[0])) ||
+      name_ == "table" || name_ == "Config" || name_ == "Fixed")
+    name_.insert(0, "k_");
+  return name_;
+};
+
+/**
+ * @brief   Quotes a string as a C++ string literal.
+ *
+ * @param   text The text
+ * @return       The literal, with quotes and backslashes escaped
+ */
+std::string quoted(std::string_view text) {
+  std::string literal_{"\""};
+  for (const char chr : text) {
+    if (chr == '"' || chr == '\\') literal_ += '\\';
+    literal_ += chr;
+  }
+  return literal_ + '"';
+};
+
+struct Options {
+  std::string type{};
+  std::string value{"double"};
+  std::string ns{"r2d2_config"};
+  std::string root{};
+  std::string input{};
+  std::string output{};
+};
+
+/**
+ * @brief   Generates the header for one configuration structure.
+ *
+ * @tparam  Type    The configuration type template
+ * @tparam  T       The value type
+ * @param   options The command-line options
+ * @param   objects The JSON objects, by key
+ * @param   out     The output stream
+ */
+template <template <typename> class Type, typename T>
+void generate(const Options& options, const nlohmann::json& objects,
+              std::ostream& out) {
+  using Config = Type<T>;
+  constexpr auto fields_{r2d2_type::config::FieldTraits<Config>::fields};
+  constexpr bool fixed_{std::apply(
+      [](const auto&... field) {
+        return (
+            is_vector<std::decay_t<decltype(Config{}.*field.second)>>::value ||
+            ...);
+      },
+      fields_)};
+  const std::string config_{"r2d2_type::config::" + options.type};
+
+  out << "namespace " << options.ns << " {\n"
+      << "using Config = " << config_ << '<' << type_name<T>() << ">;\n\n";
+
+  // Fixed-size form with one template parameter per vector
+  if constexpr (fixed_) {
+    std::ostringstream params_, members_, convert_;
+    std::size_t vectors_{0};
+    std::apply(
+        [&](const auto&... field) {
+          const char* sep_{""};
+          (
+              [&] {
+                using Member =
+                    std::decay_t<decltype(Config{}.*field.second)>;
+                convert_ << sep_;
+                sep_ = ",\n            ";
+                if constexpr (is_vector<Member>::value) {
+                  params_ << (vectors_ ? ", " : "") << "std::size_t N"
+                          << vectors_;
+                  members_ << "  std::array<"
+                           << type_name<typename Member::value_type>()
+                           << ", N" << vectors_++ << "> " << field.first
+                           << ";\n";
+                  convert_ << '{' << field.first << ".begin(), "
+                           << field.first << ".end()}";
+                } else {
+                  members_ << "  " << type_name<Member>() << ' '
+                           << field.first << ";\n";
+                  convert_ << field.first;
+                }
+              }(),
+              ...);
+        },
+        fields_);
+    out << "/**\n * @brief   Compiled-in form of " << config_
+        << ", with arrays\n *          instead of vectors.\n */\n"
+        << "template <" << params_.str() << ">\nstruct Fixed {\n"
+        << members_.str() << "\n  operator Config() const {\n"
+        << "    return {" << convert_.str() << "};\n  };\n};\n\n";
+  }
+
+  std::set<std::string> names_{}, keys_{};
+  std::ostringstream entries_;
+  for (const auto& [key, object] : objects.items()) {
+    if (!object.is_object())
+      throw std::runtime_error{"'" + key + "' is not an object"};
+    for (const auto& [member, value] : object.items()) {
+      const bool known_{std::apply(
+          [&](const auto&... field) {
+            return ((member == field.first) || ...);
+          },
+          fields_)};
+      if (!known_)
+        throw std::runtime_error{"'" + key + "': unknown field '" + member +
+                                 "' for " + options.type};
+    }
+    const std::string name_{identifier(key)};
+    if (!names_.insert(name_).second)
+      throw std::runtime_error{"'" + key + "': duplicate identifier " +
+                               name_};
+    // ConfigMap::find() ignores ASCII case, so such keys would shadow
+    std::string folded_{key};
+    for (char& chr : folded_) chr = r2d2_string::fold(chr);
+    if (!keys_.insert(folded_).second)
+      throw std::runtime_error{"'" + key +
+                               "': duplicate key ignoring ASCII case"};
+
+    std::ostringstream sizes_, values_;
+    std::apply(
+        [&](const auto&... field) {
+          const Config defaults_{};
+          const char* sep_{""};
+          (
+              [&] {
+                using Member =
+                    std::decay_t<decltype(Config{}.*field.second)>;
+                Member value_{defaults_.*field.second};
+                if (const auto it_ = object.find(field.first);
+                    it_ != object.end()) {
+                  try {
+                    value_ = it_->template get<Member>();
+                  } catch (const nlohmann::json::exception&) {
+                    throw std::runtime_error{"'" + key + "': bad value for " +
+                                             field.first};
+                  }
+                }
+                values_ << sep_;
+                sep_ = ", ";
+                if constexpr (is_vector<Member>::value) {
+                  sizes_ << (sizes_.tellp() > 0 ? ", " : "")
+                         << value_.size();
+                  values_ << '{';
+                  for (std::size_t i = 0; i < value_.size(); ++i) {
+                    if (i) values_ << ", ";
+                    write_literal(values_, value_[i]);
+                  }
+                  values_ << '}';
+                } else {
+                  write_literal(values_, value_);
+                }
+              }(),
+              ...);
+        },
+        fields_);
+
+    out << "inline constexpr ";
+    if constexpr (fixed_)
+      out << "Fixed<" << sizes_.str() << '>';
+    else
+      out << "Config";
+    out << ' ' << name_ << "{" << values_.str() << "};\n";
+    entries_ << "        {" << quoted(std::string_view{key})
+             << ", r2d2_static::make<Config, " << name_ << ">},\n";
+  }
+
+  out << "\ninline constexpr r2d2_static::ConfigMap<" << config_ << ", "
+      << type_name<T>() << ", " << names_.size() << ">\n    table{{{\n"
+      << entries_.str() << "    }}};\n"
+      << "}  // namespace " << options.ns << '\n';
+};
+
+/**
+ * @brief   Generates the header for the structure named in the options.
+ *
+ * @tparam  T The value type
+ */
+template <typename T>
+void generate(const Options& options, const nlohmann::json& objects,
+              std::ostream& out) {
+  using namespace r2d2_type::config;
+  if (options.type == "payload_t")
+    generate<payload_t, T>(options, objects, out);
+  else if (options.type == "joint_t")
+    generate<joint_t, T>(options, objects, out);
+  else if (options.type == "pipe_t")
+    generate<pipe_t, T>(options, objects, out);
+  else if (options.type == "nozzle_t")
+    generate<nozzle_t, T>(options, objects, out);
+  else
+    throw std::invalid_argument{"unknown type " + options.type};
+};
+
+Options parse_options(int argc, char** argv) {
+  Options options_{};
+  std::vector<std::string> files_{};
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg_{argv[i]};
+    if (arg_.substr(0, 2) != "--") {
+      files_.emplace_back(arg_);
+      continue;
+    }
+    if (i + 1 >= argc) throw std::invalid_argument{"missing value"};
+    const char* value_{argv[++i]};
+    if (arg_ == "--type")
+      options_.type = value_;
+    else if (arg_ == "--value")
+      options_.value = value_;
+    else if (arg_ == "--namespace")
+      options_.ns = value_;
+    else if (arg_ == "--root")
+      options_.root = value_;
+    else
+      throw std::invalid_argument{"unknown option " + std::string{arg_}};
+  }
+  if (files_.size() != 2 || options_.type.empty())
+    throw std::invalid_argument{"expected --type, INPUT and OUTPUT"};
+  options_.input = files_[0];
+  options_.output = files_[1];
+  return options_;
+};
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options_{};
+  try {
+    options_ = parse_options(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\nUsage: " << argv[0]
+              << " --type TYPE [--value double|float] [--namespace NS]"
+                 " [--root KEY] INPUT.json OUTPUT.hpp\n";
+    return 2;
+  }
+
+  try {
+    std::ifstream input_{options_.input};
+    if (!input_) throw std::runtime_error{"cannot open " + options_.input};
+    const auto document_ = nlohmann::json::parse(input_);
+    const auto& objects_{options_.root.empty() ? document_
+                                               : document_.at(options_.root)};
+    if (!objects_.is_object() || objects_.empty())
+      throw std::runtime_error{"expected an object of configurations"};
+
+    std::ostringstream body_;
+    if (options_.value == "double")
+      generate<double>(options_, objects_, body_);
+    else if (options_.value == "float")
+      generate<float>(options_, objects_, body_);
+    else
+      throw std::invalid_argument{"unknown value type " + options_.value};
+
+    std::string guard_{"R2D2_CONFIG_"};
+    for (const char chr : options_.ns + "_" + options_.type)
+      guard_ += std::isalnum(static_cast<unsigned char>(chr))
+                    ? static_cast<char>(
+                          std::toupper(static_cast<unsigned char>(chr)))
+                    : '_';
+    guard_ += "_HPP_";
+
+    std::ofstream output_{options_.output};
+    output_ << "// Generated by r2d2_gen_config from " << options_.input
+            << ".\n// Do not edit: change the JSON file and rebuild.\n"
+            << "#ifndef " << guard_ << "\n#define " << guard_ << "\n\n"
+            << "#include <array>\n#include <cstddef>\n\n"
+            << "#include \"r2d2_utils_pkg/StaticConfig.hpp\"\n"
+            << "#include \"r2d2_utils_pkg/Types.hpp\"\n\n"
+            << body_.str() << "\n#endif  // " << guard_ << '\n';
+    if (!output_) throw std::runtime_error{"cannot write " + options_.output};
+  } catch (const std::exception& e) {
+    std::cerr << options_.input << ": " << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
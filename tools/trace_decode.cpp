@@ -0,0 +1,182 @@
+/**
+ * @brief   Decodes binary traces written by r2d2_trace::TraceSink.
+ *
+ * @details Usage: r2d2_trace_decode [--json] [--plain] SEGMENT...
+ *
+ *          Segments are sorted by their sequence number. By default, every
+ *          event is printed as "[time] [thread] text", where the text is
+ *          what the asynchronous text sink would have printed (--plain
+ *          strips the ANSI colors). --json writes a Chrome/Perfetto trace
+ *          with one instant event per record instead.
+ */
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "r2d2_utils_pkg/Logging/Trace.hpp"
+
+namespace {
+/**
+ * @brief   Removes ANSI escape sequences from a string.
+ *
+ * @param   text The text
+ * @return       The text without escape sequences
+ */
+std::string strip_ansi(std::string_view text) {
+  std::string result_{};
+  result_.reserve(text.size());
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    if (text[i] != '\033') {
+      result_.push_back(text[i]);
+      continue;
+    }
+    while (i < text.size() && text[i] != 'm') ++i;
+  }
+  return result_;
+};
+
+/**
+ * @brief   Appends a string as a JSON string literal.
+ *
+ * @param   buf  The format buffer
+ * @param   text The text to escape
+ */
+void append_json_string(r2d2_format::FormatBuffer& buf,
+                        std::string_view text) {
+  buf.append("\"");
+  for (const char chr_ : text) {
+    switch (chr_) {
+      case '"': buf.append("\\\""); break;
+      case '\\': buf.append("\\\\"); break;
+      case '\n': buf.append("\\n"); break;
+      case '\t': buf.append("\\t"); break;
+      default:
+        if (static_cast<unsigned char>(chr_) < 0x20) {
+          std::array<char, 8> hex_{};
+          std::snprintf(hex_.data(), hex_.size(), "\\u%04x", chr_);
+          buf.append(hex_.data());
+        } else {
+          buf.append(std::string_view{&chr_, 1});
+        }
+    }
+  }
+  buf.append("\"");
+};
+
+/**
+ * @brief   Appends a decoded value as a JSON value.
+ *
+ * @tparam  T     The value type
+ * @param   buf   The format buffer
+ * @param   value The value
+ */
+template <typename T>
+void append_json_value(r2d2_format::FormatBuffer& buf, T value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    buf.append(value ? "true" : "false");
+  } else if constexpr (std::is_same_v<T, char>) {
+    append_json_string(buf, std::string_view{&value, 1});
+  } else if constexpr (std::is_floating_point_v<T>) {
+    if (value != value || value - value != 0)
+      append_json_string(buf, r2d2_format::paint("", value).view());
+    else
+      buf.append_value(value);
+  } else {
+    buf.append_value(+value);
+  }
+};
+
+/**
+ * @brief   Appends one Chrome trace instant event.
+ *
+ * @param   buf   The format buffer
+ * @param   event The event
+ * @param   t0Ns  Time origin of the trace
+ */
+void append_json_event(r2d2_format::FormatBuffer& buf,
+                       const r2d2_trace::TraceEvent& event, std::int64_t t0Ns) {
+  const r2d2_trace::TraceSite* site{event.site};
+  buf.append("{\"name\":");
+  if (!site)
+    append_json_string(buf, "dropped");
+  else if (!event.label.empty())
+    append_json_string(buf, event.label);
+  else
+    append_json_string(buf, site->func);
+  buf.append(",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":")
+      .append_value(event.thread)
+      .append(",\"ts\":")
+      .append_value(static_cast<double>(event.timeNs - t0Ns) / 1e3)
+      .append(",\"args\":{");
+  if (!site) {
+    buf.append("\"count\":").append_value(event.dropped);
+  } else {
+    const VarNames names_{site->names};
+    std::size_t offset_{0};
+    for (std::size_t i = 0; i < site->types.size(); ++i) {
+      if (i > 0) buf.append(",");
+      append_json_string(buf, names_[i]);
+      buf.append(":");
+      offset_ += r2d2_trace::visit_value(
+          site->types[i], event.args + offset_,
+          [&](auto value) { append_json_value(buf, value); });
+    }
+  }
+  buf.append("}}");
+};
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool json_{false}, plain_{false};
+  r2d2_trace::TraceReader reader_{};
+  try {
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg_{argv[i]};
+      if (arg_ == "--json")
+        json_ = true;
+      else if (arg_ == "--plain")
+        plain_ = true;
+      else
+        reader_.load(argv[i]);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+  if (reader_.empty()) {
+    std::cerr << "Usage: " << argv[0] << " [--json] [--plain] SEGMENT...\n";
+    return 2;
+  }
+
+  // Times are relative to the first event
+  std::int64_t t0Ns_{0};
+  bool first_{true};
+  r2d2_format::FormatBuffer buf_{};
+  std::cout << std::fixed << std::setprecision(9);
+  if (json_) std::cout << "{\"traceEvents\":[\n";
+  reader_.for_each([&](const r2d2_trace::TraceEvent& event) {
+    buf_.clear();
+    if (first_) t0Ns_ = event.timeNs;
+    if (json_) {
+      if (!first_) std::cout << ",\n";
+      append_json_event(buf_, event, t0Ns_);
+      std::cout << buf_.view();
+      first_ = false;
+      return;
+    }
+    first_ = false;
+    r2d2_trace::format_event(buf_, event);
+    std::cout << '[' << static_cast<double>(event.timeNs - t0Ns_) / 1e9
+              << "] [" << event.thread << "] "
+              << (plain_ ? strip_ansi(buf_.view()) : std::string{buf_.view()})
+              << '\n';
+  });
+  if (json_) std::cout << "\n],\"displayTimeUnit\":\"ns\"}\n";
+  return 0;
+}